@@ -4,6 +4,12 @@ pub fn build(b: *std.Build) void {
     const target = b.standardTargetOptions(.{});
     const optimize = b.standardOptimizeOption(.{ .preferred_optimize_mode = .ReleaseFast });
 
+    // Compile hot-path tracepoints into the wrapper (zero-cost when off)
+    const trace = b.option(bool, "trace", "Enable hot-path tracepoints in the wrapper library") orelse false;
+
+    // Link against lz4 and compress large v2 wire format payloads
+    const lz4 = b.option(bool, "lz4", "Enable LZ4 payload compression in the v2 wire format") orelse false;
+
     // Build Cardinal FastDDS C++ wrapper library only
     // FastDDS and Fast-CDR are built with CMake separately
     const cardinal_lib = b.addStaticLibrary(.{
@@ -13,19 +19,30 @@ pub fn build(b: *std.Build) void {
     });
 
     // Add our wrapper source file
+    var wrapper_flags = std.ArrayList([]const u8).init(b.allocator);
+    wrapper_flags.appendSlice(&[_][]const u8{
+        "-std=c++17",
+        "-fPIC",
+        "-Ilib",
+        "-Iinstall/include",
+        "-IFast-DDS/include",
+        "-IFast-CDR/include",
+    }) catch @panic("OOM");
+    if (trace) {
+        wrapper_flags.append("-DCARDINAL_TRACE_ENABLED") catch @panic("OOM");
+    }
+    if (lz4) {
+        wrapper_flags.append("-DCARDINAL_HAVE_LZ4") catch @panic("OOM");
+    }
     cardinal_lib.addCSourceFile(.{
         .file = b.path("lib/fastdds.cpp"),
-        .flags = &[_][]const u8{
-            "-std=c++17",
-            "-fPIC",
-            "-Ilib",
-            "-Iinstall/include",
-            "-IFast-DDS/include",
-            "-IFast-CDR/include",
-        },
+        .flags = wrapper_flags.items,
     });
 
     cardinal_lib.linkSystemLibrary("stdc++");
+    if (lz4) {
+        cardinal_lib.linkSystemLibrary("lz4");
+    }
     cardinal_lib.addIncludePath(b.path("lib"));
     cardinal_lib.addIncludePath(b.path("install/include"));
     cardinal_lib.addIncludePath(b.path("Fast-DDS/include"));
@@ -36,10 +53,45 @@ pub fn build(b: *std.Build) void {
         .dest_dir = .{ .override = .{ .custom = "build" } },
     });
 
+    // Benchmark binary exercising the wrapper in loopback mode
+    // (throughput, latency percentiles, allocations per sample)
+    const bench_exe = b.addExecutable(.{
+        .name = "cardinal-bench",
+        .target = target,
+        .optimize = optimize,
+    });
+
+    bench_exe.addCSourceFile(.{
+        .file = b.path("lib/bench.cpp"),
+        .flags = &[_][]const u8{
+            "-std=c++17",
+            "-Ilib",
+            "-Iinstall/include",
+        },
+    });
+
+    bench_exe.linkSystemLibrary("stdc++");
+    bench_exe.addIncludePath(b.path("lib"));
+    bench_exe.addIncludePath(b.path("install/include"));
+    bench_exe.linkLibrary(cardinal_lib);
+    bench_exe.addLibraryPath(b.path("install/lib"));
+    bench_exe.linkSystemLibrary("fastdds");
+    bench_exe.linkSystemLibrary("fastcdr");
+    if (lz4) {
+        bench_exe.linkSystemLibrary("lz4");
+    }
+
+    const install_bench = b.addInstallArtifact(bench_exe, .{
+        .dest_dir = .{ .override = .{ .custom = "build" } },
+    });
+
     // Build steps
     const lib_step = b.step("lib", "Build Cardinal FastDDS wrapper library");
     lib_step.dependOn(&install_cardinal.step);
 
+    const bench_step = b.step("bench", "Build wrapper throughput/latency benchmark");
+    bench_step.dependOn(&install_bench.step);
+
     // Default step
     b.default_step = lib_step;
 }
@@ -0,0 +1,128 @@
+// Cardinal wrapper benchmark: drives publish_simple_message() /
+// receive_simple_messages() in loopback (publisher and subscriber in one
+// process, sharing the participant) and reports throughput, latency
+// percentiles, and heap allocations per sample.
+//
+// Build with `zig build bench`, run as:
+//     cardinal-bench [message_count] [payload_bytes]
+#include "fastdds.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Count every operator new so we can report allocations per sample
+static std::atomic<unsigned long long> g_allocations{0};
+
+void* operator new(size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    void* ptr = malloc(size);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+static long now_ns() {
+    return static_cast<long>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static double percentile(std::vector<long>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1));
+    return static_cast<double>(sorted[idx]) / 1000.0; // ns -> us
+}
+
+int main(int argc, char** argv) {
+    size_t total = argc > 1 ? strtoull(argv[1], nullptr, 10) : 100000;
+    size_t payload_bytes = argc > 2 ? strtoull(argv[2], nullptr, 10) : 64;
+    if (payload_bytes > 255) {
+        payload_bytes = 255; // SimpleMessage carries at most 255 chars
+    }
+
+    SimpleDDSPublisher pub = create_simple_publisher("cardinal_bench");
+    SimpleDDSSubscriber sub = create_simple_subscriber("cardinal_bench");
+    if (!pub || !sub) {
+        fprintf(stderr, "failed to create benchmark endpoints\n");
+        return 1;
+    }
+
+    // Give discovery a moment to match the endpoints
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    std::string payload(payload_bytes, 'x');
+    std::vector<long> latencies;
+    latencies.reserve(total);
+    std::vector<SimpleMessage> batch(256);
+
+    unsigned long long allocs_before = g_allocations.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+
+    size_t sent = 0;
+    size_t received = 0;
+    while (received < total) {
+        // Publish with the send time in the timestamp field, then drain
+        // whatever has arrived and measure end-to-end latency per sample
+        if (sent < total) {
+            if (publish_simple_message(pub, payload.c_str(), now_ns()) == 0) {
+                sent++;
+            }
+        }
+
+        size_t got = 0;
+        if (receive_simple_messages(sub, batch.data(), batch.size(), &got) != 0) {
+            fprintf(stderr, "receive failed after %zu samples\n", received);
+            break;
+        }
+        long now = now_ns();
+        for (size_t i = 0; i < got; ++i) {
+            latencies.push_back(now - batch[i].timestamp);
+        }
+        received += got;
+
+        // All published; bail out if the tail never arrives
+        if (sent == total && got == 0) {
+            auto waited = std::chrono::steady_clock::now() - start;
+            if (waited > std::chrono::seconds(30)) {
+                fprintf(stderr, "timed out with %zu of %zu samples\n", received, total);
+                break;
+            }
+        }
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    unsigned long long allocs = g_allocations.load(std::memory_order_relaxed) - allocs_before;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    printf("cardinal-bench: %zu byte payloads, loopback\n", payload_bytes);
+    printf("  samples     %zu sent, %zu received\n", sent, received);
+    printf("  throughput  %.0f msgs/sec\n",
+           elapsed > 0 ? received * 1e6 / static_cast<double>(elapsed) : 0.0);
+    printf("  latency     p50 %.1f us, p99 %.1f us, p999 %.1f us\n",
+           percentile(latencies, 0.50), percentile(latencies, 0.99), percentile(latencies, 0.999));
+    printf("  allocations %.2f per sample\n",
+           received > 0 ? static_cast<double>(allocs) / static_cast<double>(received) : 0.0);
+
+    destroy_simple_subscriber(sub);
+    destroy_simple_publisher(pub);
+    return 0;
+}
@@ -5,294 +5,3455 @@
 #include <fastdds/dds/publisher/DataWriter.hpp>
 #include <fastdds/dds/subscriber/Subscriber.hpp>
 #include <fastdds/dds/subscriber/DataReader.hpp>
+#include <fastdds/dds/subscriber/DataReaderListener.hpp>
 #include <fastdds/dds/topic/Topic.hpp>
+#include <fastdds/dds/topic/ContentFilteredTopic.hpp>
+#include <fastdds/dds/topic/IContentFilter.hpp>
+#include <fastdds/dds/topic/IContentFilterFactory.hpp>
 #include <fastdds/dds/topic/TypeSupport.hpp>
 #include <fastdds/dds/subscriber/SampleInfo.hpp>
+#include <fastdds/dds/core/LoanableSequence.hpp>
+#include <fastdds/dds/core/condition/WaitSet.hpp>
+#include <fastdds/dds/core/condition/StatusCondition.hpp>
+#include <fastdds/rtps/common/Locator.hpp>
 #include <fastdds/rtps/common/SerializedPayload.hpp>
+#include <fastdds/utils/IPLocator.hpp>
+#include <fastdds/rtps/flowcontrol/FlowControllerDescriptor.hpp>
+#include <fastdds/rtps/transport/UDPv4TransportDescriptor.hpp>
+#include <fastdds/rtps/transport/shared_mem/SharedMemTransportDescriptor.hpp>
+#include <fastcdr/Cdr.h>
+#include <fastcdr/FastBuffer.h>
 #include <string>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
 #include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef CARDINAL_HAVE_LZ4
+#include <lz4.h>
+#endif
 
 using namespace eprosima::fastdds::dds;
 using namespace eprosima::fastdds::rtps;
 
-// Simple message class for Fast DDS
+// ---------------------------------------------------------------------------
+// Hot-path tracepoints (see cardinal_set_trace_callback). Built only with
+// -DCARDINAL_TRACE_ENABLED (zig build -Dtrace=true); otherwise the macro
+// expands to nothing and the hot paths carry no trace code at all.
+// ---------------------------------------------------------------------------
+#ifdef CARDINAL_TRACE_ENABLED
+static std::atomic<CardinalTraceCallback> g_trace_callback{nullptr};
+static std::atomic<void*> g_trace_context{nullptr};
+
+// Scoped probe: fires the registered callback with the nanoseconds spent in
+// the enclosing scope
+class TraceSpan {
+public:
+    explicit TraceSpan(int point)
+        : point_(point), start_(std::chrono::steady_clock::now()) {}
+
+    ~TraceSpan() {
+        CardinalTraceCallback cb = g_trace_callback.load(std::memory_order_acquire);
+        if (cb) {
+            uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start_).count());
+            cb(point_, ns, g_trace_context.load(std::memory_order_acquire));
+        }
+    }
+
+private:
+    int point_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+#define CARDINAL_TRACE_SPAN(point) TraceSpan cardinal_trace_span_(point)
+#else
+#define CARDINAL_TRACE_SPAN(point)
+#endif
+
+// Simple message class for Fast DDS. key identifies the DDS instance on
+// keyed topics (0 for unkeyed publishers).
 class SimpleMessageData {
 public:
     std::string message;
-    int64_t timestamp;
+    int64_t timestamp = 0;
+    uint32_t key = 0;
 
     SimpleMessageData() = default;
     SimpleMessageData(const std::string& msg, int64_t ts) : message(msg), timestamp(ts) {}
 };
 
+// ---------------------------------------------------------------------------
+// Sample pool: recycles SimpleMessageData instances -- and, importantly, the
+// capacity of their strings -- so the steady-state publish/receive paths make
+// zero heap allocations. Freelists are thread-local, so no locking either.
+// ---------------------------------------------------------------------------
+static constexpr size_t kSamplePoolLimit = 256; // per thread
+
+struct SamplePool {
+    std::vector<SimpleMessageData*> items;
+
+    ~SamplePool() {
+        for (SimpleMessageData* sample : items) {
+            delete sample;
+        }
+    }
+};
+
+static thread_local SamplePool t_sample_pool;
+
+static SimpleMessageData* acquire_sample() {
+    if (!t_sample_pool.items.empty()) {
+        SimpleMessageData* sample = t_sample_pool.items.back();
+        t_sample_pool.items.pop_back();
+        return sample;
+    }
+    return new SimpleMessageData();
+}
+
+static void release_sample(SimpleMessageData* sample) {
+    if (sample && t_sample_pool.items.size() < kSamplePoolLimit) {
+        sample->message.clear(); // drop contents, keep capacity
+        t_sample_pool.items.push_back(sample);
+    } else {
+        delete sample;
+    }
+}
+
+// Upper bound for a serialized message; drives reader/writer pool sizing
+static constexpr uint32_t kMaxSerializedMessageSize = 64 * 1024;
+
+// Single layout definition shared by serialize() and
+// calculate_serialized_size(): uint32 key first (so compute_key can pull it
+// straight out of a serialized payload), then the CDR string (uint32 length +
+// chars + NUL), padding up to 8-byte alignment, then int64 timestamp.
+static uint32_t simple_message_cdr_size(const SimpleMessageData& msg) {
+    uint32_t size = sizeof(uint32_t) + sizeof(uint32_t) + static_cast<uint32_t>(msg.message.length()) + 1;
+    size = (size + 7u) & ~7u;
+    size += sizeof(int64_t);
+    return size;
+}
+
 // Simplified TypeSupport for Fast DDS
 class SimpleMessageTypeSupport : public TopicDataType {
 public:
     SimpleMessageTypeSupport() {
         set_name("SimpleMessage");
-        max_serialized_type_size = 300; // 256 + some overhead
+        max_serialized_type_size = kMaxSerializedMessageSize;
+        is_compute_key_provided = true;
+    }
+
+    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_SERIALIZE);
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+
+        try {
+            payload.reserve(simple_message_cdr_size(*msg_data));
+
+            // Serialize straight into the payload buffer with Fast-CDR
+            eprosima::fastcdr::FastBuffer buffer(reinterpret_cast<char*>(payload.data), payload.max_size);
+            eprosima::fastcdr::Cdr cdr(buffer);
+
+            cdr << msg_data->key;
+            cdr << msg_data->message;
+            cdr << msg_data->timestamp;
+
+            payload.length = static_cast<uint32_t>(cdr.get_serialized_data_length());
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Serialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool deserialize(SerializedPayload_t& payload, void* data) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_DESERIALIZE);
+        SimpleMessageData* msg_data = static_cast<SimpleMessageData*>(data);
+
+        try {
+            // Deserialize in place: the string assign reuses the sample's
+            // existing capacity, so no intermediate buffer and no 256-byte cap
+            eprosima::fastcdr::FastBuffer buffer(reinterpret_cast<char*>(payload.data), payload.length);
+            eprosima::fastcdr::Cdr cdr(buffer);
+
+            cdr >> msg_data->key;
+            cdr >> msg_data->message;
+            cdr >> msg_data->timestamp;
+
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Deserialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+        return simple_message_cdr_size(*msg_data);
+    }
+
+    void* create_data() override {
+        return acquire_sample();
+    }
+
+    void delete_data(void* data) override {
+        release_sample(static_cast<SimpleMessageData*>(data));
+    }
+
+    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
+        // The key is the first field of the wire format
+        if (payload.length < sizeof(uint32_t)) {
+            return false;
+        }
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, payload.data, sizeof(uint32_t));
+        return true;
+    }
+
+    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
+        // A 4-byte key fits the 16-byte handle directly; no md5 needed
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, &msg_data->key, sizeof(uint32_t));
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Wire format v2 for SimpleMessage: varint framing instead of fixed-width CDR
+// fields, which cuts ~40% of the overhead on short messages. Registered as
+// its own topic type ("SimpleMessageV2"), so a topic switches format by both
+// sides opting in via CardinalQos.wire_format; mixed endpoints never match
+// and the v1 path is untouched. Layout, per sample:
+//   flags byte (bit 0: payload LZ4-compressed)
+//   varint key
+//   varint payload length (uncompressed)
+//   [varint compressed length + compressed bytes | raw payload bytes]
+//   zigzag-varint timestamp
+// Every sample decodes standalone -- no cross-sample deltas -- because DDS
+// readers can join late or lose samples under best-effort QoS.
+// ---------------------------------------------------------------------------
+static size_t varint_encode(uint64_t value, uint8_t* out) {
+    size_t n = 0;
+    while (value >= 0x80) {
+        out[n++] = static_cast<uint8_t>(value) | 0x80;
+        value >>= 7;
+    }
+    out[n++] = static_cast<uint8_t>(value);
+    return n;
+}
+
+static bool varint_decode(const uint8_t*& cursor, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; cursor < end && shift < 64; shift += 7) {
+        uint8_t byte = *cursor++;
+        value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Zigzag so small negative timestamps stay short varints
+static uint64_t zigzag_encode(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+static int64_t zigzag_decode(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+#ifdef CARDINAL_HAVE_LZ4
+// Payloads at or above this compress; below it the LZ4 header overhead and
+// the extra memcpy are not worth it
+static constexpr size_t kCompressThreshold = 512;
+#endif
+
+// Worst case: flags byte, three 10-byte varints, raw payload (compression is
+// only kept when it shrinks the payload)
+static uint32_t simple_message_v2_size_bound(const SimpleMessageData& msg) {
+    return 1 + 3 * 10 + static_cast<uint32_t>(msg.message.length());
+}
+
+class SimpleMessageV2TypeSupport : public TopicDataType {
+public:
+    SimpleMessageV2TypeSupport() {
+        set_name("SimpleMessageV2");
+        max_serialized_type_size = kMaxSerializedMessageSize;
+        is_compute_key_provided = true;
+    }
+
+    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_SERIALIZE);
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+
+        try {
+            payload.reserve(simple_message_v2_size_bound(*msg_data));
+            uint8_t* out = reinterpret_cast<uint8_t*>(payload.data);
+            size_t length = msg_data->message.length();
+            size_t pos = 1; // flags byte written last
+            uint8_t flags = 0;
+
+            pos += varint_encode(msg_data->key, out + pos);
+            pos += varint_encode(length, out + pos);
+
+#ifdef CARDINAL_HAVE_LZ4
+            if (length >= kCompressThreshold) {
+                // Compress into a recycled scratch buffer; only keep the
+                // result if it actually shrank
+                static thread_local std::vector<char> scratch;
+                scratch.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(length))));
+                int compressed = LZ4_compress_default(msg_data->message.data(), scratch.data(),
+                                                      static_cast<int>(length),
+                                                      static_cast<int>(scratch.size()));
+                if (compressed > 0 && static_cast<size_t>(compressed) < length) {
+                    flags |= 0x01;
+                    pos += varint_encode(static_cast<uint64_t>(compressed), out + pos);
+                    memcpy(out + pos, scratch.data(), static_cast<size_t>(compressed));
+                    pos += static_cast<size_t>(compressed);
+                }
+            }
+#endif
+            if (!(flags & 0x01)) {
+                memcpy(out + pos, msg_data->message.data(), length);
+                pos += length;
+            }
+
+            pos += varint_encode(zigzag_encode(msg_data->timestamp), out + pos);
+            out[0] = flags;
+            payload.length = static_cast<uint32_t>(pos);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "V2 serialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool deserialize(SerializedPayload_t& payload, void* data) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_DESERIALIZE);
+        SimpleMessageData* msg_data = static_cast<SimpleMessageData*>(data);
+
+        try {
+            const uint8_t* cursor = reinterpret_cast<const uint8_t*>(payload.data);
+            const uint8_t* end = cursor + payload.length;
+            if (cursor >= end) {
+                return false;
+            }
+            uint8_t flags = *cursor++;
+
+            uint64_t key = 0;
+            uint64_t length = 0;
+            if (!varint_decode(cursor, end, key) || !varint_decode(cursor, end, length) ||
+                length > kMaxSerializedMessageSize) {
+                return false;
+            }
+            msg_data->key = static_cast<uint32_t>(key);
+
+            if (flags & 0x01) {
+#ifdef CARDINAL_HAVE_LZ4
+                uint64_t compressed = 0;
+                if (!varint_decode(cursor, end, compressed) ||
+                    compressed > static_cast<uint64_t>(end - cursor)) {
+                    return false;
+                }
+                msg_data->message.resize(static_cast<size_t>(length));
+                if (LZ4_decompress_safe(reinterpret_cast<const char*>(cursor), &msg_data->message[0],
+                                        static_cast<int>(compressed),
+                                        static_cast<int>(length)) != static_cast<int>(length)) {
+                    return false;
+                }
+                cursor += compressed;
+#else
+                std::cerr << "Received compressed sample but built without LZ4" << std::endl;
+                return false;
+#endif
+            } else {
+                if (length > static_cast<uint64_t>(end - cursor)) {
+                    return false;
+                }
+                msg_data->message.assign(reinterpret_cast<const char*>(cursor),
+                                         static_cast<size_t>(length));
+                cursor += length;
+            }
+
+            uint64_t encoded_timestamp = 0;
+            if (!varint_decode(cursor, end, encoded_timestamp)) {
+                return false;
+            }
+            msg_data->timestamp = zigzag_decode(encoded_timestamp);
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "V2 deserialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+        return simple_message_v2_size_bound(*msg_data);
+    }
+
+    void* create_data() override {
+        return acquire_sample();
+    }
+
+    void delete_data(void* data) override {
+        release_sample(static_cast<SimpleMessageData*>(data));
+    }
+
+    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
+        // Key is the varint right after the flags byte
+        const uint8_t* cursor = reinterpret_cast<const uint8_t*>(payload.data);
+        const uint8_t* end = cursor + payload.length;
+        uint64_t key = 0;
+        if (cursor >= end || !varint_decode(++cursor, end, key)) {
+            return false;
+        }
+        uint32_t key32 = static_cast<uint32_t>(key);
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, &key32, sizeof(uint32_t));
+        return true;
+    }
+
+    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
+        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, &msg_data->key, sizeof(uint32_t));
+        return true;
+    }
+};
+
+// Binary payload class for blob topics
+class CardinalBlobData {
+public:
+    std::vector<uint8_t> payload;
+    int64_t timestamp = 0;
+};
+
+// Upper bound for a serialized blob
+static constexpr uint32_t kMaxSerializedBlobSize = 1024 * 1024;
+
+// Layout shared by serialize() and calculate_serialized_size(): CDR byte
+// sequence (uint32 length + bytes), padding to 8-byte alignment, int64 timestamp
+static uint32_t blob_cdr_size(const CardinalBlobData& blob) {
+    uint32_t size = sizeof(uint32_t) + static_cast<uint32_t>(blob.payload.size());
+    size = (size + 7u) & ~7u;
+    size += sizeof(int64_t);
+    return size;
+}
+
+// TypeSupport for raw binary payloads
+class CardinalBlobTypeSupport : public TopicDataType {
+public:
+    CardinalBlobTypeSupport() {
+        set_name("CardinalBlob");
+        max_serialized_type_size = kMaxSerializedBlobSize;
         is_compute_key_provided = false;
     }
 
-    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
-        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
-        
-        // Simple serialization: message length + message + timestamp
-        uint32_t msg_len = static_cast<uint32_t>(msg_data->message.length());
-        
-        payload.reserve(sizeof(uint32_t) + msg_len + sizeof(int64_t));
-        payload.pos = 0;
-        
-        // Serialize message length
-        memcpy(payload.data + payload.pos, &msg_len, sizeof(uint32_t));
-        payload.pos += sizeof(uint32_t);
-        
-        // Serialize message
-        memcpy(payload.data + payload.pos, msg_data->message.c_str(), msg_len);
-        payload.pos += msg_len;
-        
-        // Serialize timestamp
-        memcpy(payload.data + payload.pos, &msg_data->timestamp, sizeof(int64_t));
-        payload.pos += sizeof(int64_t);
-        
-        payload.length = payload.pos;
-        return true;
+    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_SERIALIZE);
+        const CardinalBlobData* blob = static_cast<const CardinalBlobData*>(data);
+
+        try {
+            payload.reserve(blob_cdr_size(*blob));
+
+            eprosima::fastcdr::FastBuffer buffer(reinterpret_cast<char*>(payload.data), payload.max_size);
+            eprosima::fastcdr::Cdr cdr(buffer);
+
+            cdr << blob->payload;
+            cdr << blob->timestamp;
+
+            payload.length = static_cast<uint32_t>(cdr.get_serialized_data_length());
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Blob serialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    bool deserialize(SerializedPayload_t& payload, void* data) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_DESERIALIZE);
+        CardinalBlobData* blob = static_cast<CardinalBlobData*>(data);
+
+        try {
+            eprosima::fastcdr::FastBuffer buffer(reinterpret_cast<char*>(payload.data), payload.length);
+            eprosima::fastcdr::Cdr cdr(buffer);
+
+            cdr >> blob->payload;
+            cdr >> blob->timestamp;
+
+            return true;
+        } catch (const std::exception& e) {
+            std::cerr << "Blob deserialization failed: " << e.what() << std::endl;
+            return false;
+        }
+    }
+
+    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
+        const CardinalBlobData* blob = static_cast<const CardinalBlobData*>(data);
+        return blob_cdr_size(*blob);
+    }
+
+    void* create_data() override {
+        return new CardinalBlobData();
+    }
+
+    void delete_data(void* data) override {
+        delete static_cast<CardinalBlobData*>(data);
+    }
+
+    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
+        return true;
+    }
+
+    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
+        return true;
+    }
+};
+
+// TypeSupport for CardinalSample. The struct is its own wire format: 24
+// bytes, naturally aligned, key first so compute_key can read it straight
+// out of a serialized payload. Serialize/deserialize are single memcpys.
+static_assert(sizeof(CardinalSample) == 24, "CardinalSample must stay a packed 24-byte POD");
+
+class CardinalSampleTypeSupport : public TopicDataType {
+public:
+    CardinalSampleTypeSupport() {
+        set_name("CardinalSample");
+        max_serialized_type_size = sizeof(CardinalSample);
+        is_compute_key_provided = true;
+    }
+
+    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_SERIALIZE);
+        payload.reserve(sizeof(CardinalSample));
+        memcpy(payload.data, data, sizeof(CardinalSample));
+        payload.length = sizeof(CardinalSample);
+        return true;
+    }
+
+    bool deserialize(SerializedPayload_t& payload, void* data) override {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_DESERIALIZE);
+        if (payload.length < sizeof(CardinalSample)) {
+            return false;
+        }
+        memcpy(data, payload.data, sizeof(CardinalSample));
+        return true;
+    }
+
+    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
+        return sizeof(CardinalSample);
+    }
+
+    void* create_data() override {
+        return new CardinalSample();
+    }
+
+    void delete_data(void* data) override {
+        delete static_cast<CardinalSample*>(data);
+    }
+
+    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
+        if (payload.length < sizeof(uint32_t)) {
+            return false;
+        }
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, payload.data, sizeof(uint32_t));
+        return true;
+    }
+
+    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
+        const CardinalSample* sample = static_cast<const CardinalSample*>(data);
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, &sample->key, sizeof(uint32_t));
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Raw pass-through type for the cross-domain bridge: deserialize copies the
+// serialized payload bytes into the holder and serialize copies them back
+// out, so bridged samples are never decoded. Registered under the bridged
+// type's name ("SimpleMessage") so it matches the real endpoints on both
+// domains; the key still lives in the first 4 payload bytes, so instance
+// bookkeeping survives the bridge.
+// ---------------------------------------------------------------------------
+struct RawSampleData {
+    std::vector<uint8_t> bytes;
+};
+
+class RawPassthroughTypeSupport : public TopicDataType {
+public:
+    explicit RawPassthroughTypeSupport(const char* type_name) {
+        set_name(type_name);
+        max_serialized_type_size = kMaxSerializedMessageSize;
+        is_compute_key_provided = true;
+    }
+
+    bool serialize(const void* data, SerializedPayload_t& payload, DataRepresentationId_t representation) override {
+        const RawSampleData* raw = static_cast<const RawSampleData*>(data);
+        payload.reserve(static_cast<uint32_t>(raw->bytes.size()));
+        memcpy(payload.data, raw->bytes.data(), raw->bytes.size());
+        payload.length = static_cast<uint32_t>(raw->bytes.size());
+        return true;
+    }
+
+    bool deserialize(SerializedPayload_t& payload, void* data) override {
+        RawSampleData* raw = static_cast<RawSampleData*>(data);
+        raw->bytes.assign(payload.data, payload.data + payload.length);
+        return true;
+    }
+
+    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
+        return static_cast<uint32_t>(static_cast<const RawSampleData*>(data)->bytes.size());
+    }
+
+    void* create_data() override {
+        return new RawSampleData();
+    }
+
+    void delete_data(void* data) override {
+        delete static_cast<RawSampleData*>(data);
+    }
+
+    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
+        if (payload.length < sizeof(uint32_t)) {
+            return false;
+        }
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, payload.data, sizeof(uint32_t));
+        return true;
+    }
+
+    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
+        const RawSampleData* raw = static_cast<const RawSampleData*>(data);
+        if (raw->bytes.size() < sizeof(uint32_t)) {
+            return false;
+        }
+        memset(handle.value, 0, sizeof(handle.value));
+        memcpy(handle.value, raw->bytes.data(), sizeof(uint32_t));
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Content filtering. Fast DDS's builtin DDSSQL filter resolves field names
+// through the type's registered TypeObject, which the hand-rolled
+// TopicDataTypes here never provide -- with the default factory every
+// create_contentfilteredtopic() call fails at runtime. The wrapper therefore
+// registers its own filter class that evaluates expressions directly against
+// the SimpleMessage wire format, with no deserialization. Supported grammar:
+// "field op literal" terms over key, timestamp, and message, joined by
+// AND/OR (AND binds tighter, as in SQL; no parentheses or parameters); ops
+// are = != <> < <= > >= and string literals are single-quoted.
+// ---------------------------------------------------------------------------
+static constexpr const char* kCardinalFilterClass = "CARDINAL_SIMPLE_FILTER";
+
+struct FilterTerm {
+    enum Field { FIELD_KEY, FIELD_TIMESTAMP, FIELD_MESSAGE };
+    enum Op { OP_EQ, OP_NE, OP_LT, OP_LE, OP_GT, OP_GE };
+    Field field = FIELD_KEY;
+    Op op = OP_EQ;
+    int64_t number = 0;      // key / timestamp comparisons
+    std::string text;        // message comparisons
+    bool or_before = false;  // term starts a new OR group
+};
+
+static bool tokenize_filter(const char* expression, std::vector<std::string>& tokens) {
+    for (const char* p = expression; *p;) {
+        if (isspace(static_cast<unsigned char>(*p))) {
+            ++p;
+        } else if (*p == '\'') {
+            const char* end = strchr(p + 1, '\'');
+            if (!end) {
+                return false; // unterminated string literal
+            }
+            tokens.emplace_back(p, end + 1 - p); // keep the quotes
+            p = end + 1;
+        } else if (*p == '=' || *p == '<' || *p == '>' || *p == '!') {
+            const char* start = p++;
+            if ((*start == '<' && (*p == '=' || *p == '>')) ||
+                ((*start == '>' || *start == '!' || *start == '=') && *p == '=')) {
+                ++p;
+            }
+            tokens.emplace_back(start, p - start);
+        } else if (isalnum(static_cast<unsigned char>(*p)) || *p == '_' || *p == '-') {
+            const char* start = p;
+            while (isalnum(static_cast<unsigned char>(*p)) || *p == '_' || *p == '-') {
+                ++p;
+            }
+            tokens.emplace_back(start, p - start);
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool parse_filter_expression(const char* expression, std::vector<FilterTerm>& terms) {
+    std::vector<std::string> tokens;
+    if (!tokenize_filter(expression, tokens) || tokens.empty()) {
+        return false;
+    }
+
+    size_t i = 0;
+    bool or_before = false;
+    while (i < tokens.size()) {
+        if (i + 3 > tokens.size()) {
+            return false; // dangling field or operator
+        }
+
+        FilterTerm term;
+        term.or_before = or_before;
+
+        const std::string& field = tokens[i];
+        if (field == "key") {
+            term.field = FilterTerm::FIELD_KEY;
+        } else if (field == "timestamp") {
+            term.field = FilterTerm::FIELD_TIMESTAMP;
+        } else if (field == "message") {
+            term.field = FilterTerm::FIELD_MESSAGE;
+        } else {
+            return false;
+        }
+
+        const std::string& op = tokens[i + 1];
+        if (op == "=" || op == "==") {
+            term.op = FilterTerm::OP_EQ;
+        } else if (op == "!=" || op == "<>") {
+            term.op = FilterTerm::OP_NE;
+        } else if (op == "<") {
+            term.op = FilterTerm::OP_LT;
+        } else if (op == "<=") {
+            term.op = FilterTerm::OP_LE;
+        } else if (op == ">") {
+            term.op = FilterTerm::OP_GT;
+        } else if (op == ">=") {
+            term.op = FilterTerm::OP_GE;
+        } else {
+            return false;
+        }
+
+        const std::string& literal = tokens[i + 2];
+        if (term.field == FilterTerm::FIELD_MESSAGE) {
+            if (literal.length() < 2 || literal.front() != '\'' || literal.back() != '\'') {
+                return false; // message compares against a quoted string
+            }
+            term.text = literal.substr(1, literal.length() - 2);
+        } else {
+            char* end = nullptr;
+            term.number = strtoll(literal.c_str(), &end, 10);
+            if (end == literal.c_str() || *end != '\0') {
+                return false; // key/timestamp compare against an integer
+            }
+        }
+        terms.push_back(std::move(term));
+        i += 3;
+
+        if (i == tokens.size()) {
+            break;
+        }
+        std::string conj = tokens[i++];
+        for (char& c : conj) {
+            c = static_cast<char>(tolower(static_cast<unsigned char>(c)));
+        }
+        if (conj == "and") {
+            or_before = false;
+        } else if (conj == "or") {
+            or_before = true;
+        } else {
+            return false;
+        }
+        if (i == tokens.size()) {
+            return false; // trailing conjunction with no term after it
+        }
+    }
+    return true;
+}
+
+class SimpleMessageContentFilter : public IContentFilter {
+public:
+    explicit SimpleMessageContentFilter(std::vector<FilterTerm> terms) : terms_(std::move(terms)) {}
+
+    bool evaluate(const SerializedPayload& payload, const FilterSampleInfo& sample_info,
+                  const GUID_t& reader_guid) const override {
+        (void)sample_info;
+        (void)reader_guid;
+
+        // Decode the layout shared with SimpleMessageTypeSupport: uint32 key,
+        // uint32 string length (incl. NUL), chars, pad to 8, int64 timestamp
+        if (payload.length < 2 * sizeof(uint32_t)) {
+            return false;
+        }
+        uint32_t key = 0;
+        uint32_t str_len = 0;
+        memcpy(&key, payload.data, sizeof(uint32_t));
+        memcpy(&str_len, payload.data + sizeof(uint32_t), sizeof(uint32_t));
+
+        uint64_t text_off = 2 * sizeof(uint32_t);
+        if (str_len == 0 || text_off + str_len > payload.length) {
+            return false;
+        }
+        const char* text = reinterpret_cast<const char*>(payload.data) + text_off;
+        size_t text_len = str_len - 1; // trailing NUL
+
+        uint64_t ts_off = (text_off + str_len + 7u) & ~static_cast<uint64_t>(7u);
+        if (ts_off + sizeof(int64_t) > payload.length) {
+            return false;
+        }
+        int64_t timestamp = 0;
+        memcpy(&timestamp, payload.data + ts_off, sizeof(int64_t));
+
+        // AND binds tighter than OR: fold each AND run, then OR the runs
+        bool result = false;
+        bool group = true;
+        for (const FilterTerm& term : terms_) {
+            if (term.or_before) {
+                result = result || group;
+                group = true;
+            }
+            if (group) {
+                group = match(term, key, timestamp, text, text_len);
+            }
+        }
+        return result || group;
+    }
+
+private:
+    static bool match(const FilterTerm& term, uint32_t key, int64_t timestamp,
+                      const char* text, size_t text_len) {
+        int cmp = 0;
+        if (term.field == FilterTerm::FIELD_MESSAGE) {
+            size_t lit_len = term.text.length();
+            cmp = memcmp(text, term.text.data(), text_len < lit_len ? text_len : lit_len);
+            if (cmp == 0 && text_len != lit_len) {
+                cmp = text_len < lit_len ? -1 : 1;
+            }
+        } else {
+            int64_t value = term.field == FilterTerm::FIELD_KEY ? static_cast<int64_t>(key) : timestamp;
+            cmp = value < term.number ? -1 : (value > term.number ? 1 : 0);
+        }
+
+        switch (term.op) {
+            case FilterTerm::OP_EQ: return cmp == 0;
+            case FilterTerm::OP_NE: return cmp != 0;
+            case FilterTerm::OP_LT: return cmp < 0;
+            case FilterTerm::OP_LE: return cmp <= 0;
+            case FilterTerm::OP_GT: return cmp > 0;
+            case FilterTerm::OP_GE: return cmp >= 0;
+        }
+        return false;
+    }
+
+    std::vector<FilterTerm> terms_;
+};
+
+class CardinalFilterFactory : public IContentFilterFactory {
+public:
+    ReturnCode_t create_content_filter(const char* filter_class_name, const char* type_name,
+                                       const TopicDataType* data_type, const char* filter_expression,
+                                       const ParameterSeq& filter_parameters,
+                                       IContentFilter*& filter_instance) override {
+        (void)data_type;
+        (void)filter_parameters;
+        if (strcmp(filter_class_name, kCardinalFilterClass) != 0 ||
+            strcmp(type_name, "SimpleMessage") != 0 || !filter_expression) {
+            return RETCODE_BAD_PARAMETER;
+        }
+
+        std::vector<FilterTerm> terms;
+        if (!parse_filter_expression(filter_expression, terms)) {
+            return RETCODE_BAD_PARAMETER;
+        }
+        filter_instance = new SimpleMessageContentFilter(std::move(terms));
+        return RETCODE_OK;
+    }
+
+    ReturnCode_t delete_content_filter(const char* filter_class_name, IContentFilter* filter_instance) override {
+        (void)filter_class_name;
+        delete filter_instance;
+        return RETCODE_OK;
+    }
+};
+
+static CardinalFilterFactory g_filter_factory;
+
+// ---------------------------------------------------------------------------
+// Participant pool: one reference-counted DomainParticipant per domain, so
+// every endpoint in the process shares a single set of discovery threads and
+// sockets instead of spinning up a participant each. Topics hang off the
+// shared participant and are reference-counted by name, since a publisher
+// and subscriber on the same topic now live on the same participant.
+// ---------------------------------------------------------------------------
+struct TopicEntry {
+    Topic* topic = nullptr;
+    std::string type_name; // guards against reuse under a different type
+    int refcount = 0;
+};
+
+struct ParticipantEntry {
+    DomainParticipant* participant = nullptr;
+    TypeSupport type_support;                        // SimpleMessage, registered once
+    TypeSupport v2_type_support;                     // SimpleMessageV2, registered once
+    TypeSupport blob_type_support;                   // CardinalBlob, registered once
+    TypeSupport sample_type_support;                 // CardinalSample, registered once
+    std::map<std::string, TopicEntry> topics;        // keyed by topic name
+    // Publisher/Subscriber factory objects, shared per partition name ("" for
+    // the default partition). With these cached, creating an endpoint on an
+    // already-used topic only creates the DataWriter/DataReader.
+    std::map<std::string, std::pair<Publisher*, int>> publishers;
+    std::map<std::string, std::pair<Subscriber*, int>> subscribers;
+    int refcount = 0;
+};
+
+static std::mutex g_participant_mutex;
+static std::map<uint32_t, ParticipantEntry> g_participants;
+
+// Name of the shared writer flow controller (see CardinalQos.max_bytes_per_period)
+static constexpr const char* kFlowControllerName = "cardinal_flow";
+
+// Parse a comma-separated "host" / "host:port" list into the participant's
+// initial peers, so discovery can match over unicast without waiting for
+// multicast SPDP announcements
+static void apply_initial_peers(DomainParticipantQos& participant_qos, const char* peers) {
+    std::string list(peers);
+    size_t start = 0;
+
+    while (start < list.size()) {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        std::string peer = list.substr(start, end - start);
+        start = end + 1;
+        if (peer.empty()) {
+            continue;
+        }
+
+        std::string host = peer;
+        uint32_t port = 0;
+        size_t colon = peer.rfind(':');
+        if (colon != std::string::npos) {
+            host = peer.substr(0, colon);
+            port = static_cast<uint32_t>(atoi(peer.substr(colon + 1).c_str()));
+        }
+
+        Locator_t locator;
+        locator.kind = LOCATOR_KIND_UDPv4;
+        if (!IPLocator::setIPv4(locator, host)) {
+            std::cerr << "Ignoring malformed initial peer: " << peer << std::endl;
+            continue;
+        }
+        if (port > 0) {
+            locator.port = port;
+        }
+        participant_qos.wire_protocol().builtin.initialPeersList.push_back(locator);
+    }
+}
+
+static ParticipantEntry* cardinal_get_participant(uint32_t domain_id, const CardinalQos* qos) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    ParticipantEntry& entry = g_participants[domain_id];
+    if (!entry.participant) {
+        // Participant-level tuning only takes effect for the first creator in
+        // a domain; everyone else shares the participant it configured
+        DomainParticipantQos participant_qos = PARTICIPANT_QOS_DEFAULT;
+        if (qos) {
+            if (qos->send_socket_buffer_size > 0) {
+                participant_qos.transport().send_socket_buffer_size = qos->send_socket_buffer_size;
+            }
+            if (qos->recv_socket_buffer_size > 0) {
+                participant_qos.transport().listen_socket_buffer_size = qos->recv_socket_buffer_size;
+            }
+
+            if (qos->initial_peers && qos->initial_peers[0]) {
+                apply_initial_peers(participant_qos, qos->initial_peers);
+            }
+
+            if (qos->max_bytes_per_period > 0) {
+                // Flow controllers can only be registered at participant
+                // creation; writers opt in by name via apply_writer_qos()
+                auto flow = std::make_shared<FlowControllerDescriptor>();
+                flow->name = kFlowControllerName;
+                flow->scheduler = FlowControllerSchedulerPolicy::FIFO;
+                flow->max_bytes_per_period = static_cast<int32_t>(qos->max_bytes_per_period);
+                flow->period_ms = qos->flow_period_ms > 0 ? qos->flow_period_ms : 100;
+                participant_qos.flow_controllers().push_back(flow);
+            }
+
+            if (qos->transport == CARDINAL_TRANSPORT_SHM) {
+                // Same-host mode: shared-memory transport only, so samples
+                // never touch the kernel networking stack
+                participant_qos.transport().use_builtin_transports = false;
+                participant_qos.transport().user_transports.push_back(
+                    std::make_shared<SharedMemTransportDescriptor>());
+            } else if (qos->transport == CARDINAL_TRANSPORT_UDP) {
+                participant_qos.transport().use_builtin_transports = false;
+                auto udp = std::make_shared<UDPv4TransportDescriptor>();
+                if (qos->send_socket_buffer_size > 0) {
+                    udp->sendBufferSize = qos->send_socket_buffer_size;
+                }
+                if (qos->recv_socket_buffer_size > 0) {
+                    udp->receiveBufferSize = qos->recv_socket_buffer_size;
+                }
+                participant_qos.transport().user_transports.push_back(udp);
+            }
+        }
+
+        entry.participant = DomainParticipantFactory::get_instance()->create_participant(
+            domain_id, participant_qos);
+        if (!entry.participant) {
+            g_participants.erase(domain_id);
+            return nullptr;
+        }
+
+        entry.type_support = TypeSupport(new SimpleMessageTypeSupport());
+        entry.v2_type_support = TypeSupport(new SimpleMessageV2TypeSupport());
+        entry.blob_type_support = TypeSupport(new CardinalBlobTypeSupport());
+        entry.sample_type_support = TypeSupport(new CardinalSampleTypeSupport());
+        if (entry.type_support.register_type(entry.participant) != RETCODE_OK ||
+            entry.v2_type_support.register_type(entry.participant) != RETCODE_OK ||
+            entry.blob_type_support.register_type(entry.participant) != RETCODE_OK ||
+            entry.sample_type_support.register_type(entry.participant) != RETCODE_OK ||
+            entry.participant->register_content_filter_factory(
+                kCardinalFilterClass, &g_filter_factory) != RETCODE_OK) {
+            DomainParticipantFactory::get_instance()->delete_participant(entry.participant);
+            g_participants.erase(domain_id);
+            return nullptr;
+        }
+    }
+
+    entry.refcount++;
+    return &entry;
+}
+
+static void cardinal_release_participant(uint32_t domain_id) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    auto it = g_participants.find(domain_id);
+    if (it == g_participants.end()) {
+        return;
+    }
+
+    if (--it->second.refcount <= 0) {
+        DomainParticipantFactory::get_instance()->delete_participant(it->second.participant);
+        g_participants.erase(it);
+    }
+}
+
+static Topic* cardinal_get_topic(ParticipantEntry* entry, const char* topic_name, const char* type_name) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    auto it = entry->topics.find(topic_name);
+    if (it != entry->topics.end()) {
+        // A cached topic only serves endpoints of the type it was created
+        // with -- handing it to another type would make readers deserialize
+        // with the wrong TopicDataType. Fail like create_topic() does on a
+        // conflicting type.
+        if (it->second.type_name != type_name) {
+            std::cerr << "Topic '" << topic_name << "' already uses type "
+                      << it->second.type_name << ", cannot reuse it as " << type_name << std::endl;
+            return nullptr;
+        }
+        it->second.refcount++;
+        return it->second.topic;
+    }
+
+    Topic* topic = entry->participant->create_topic(topic_name, type_name, TOPIC_QOS_DEFAULT);
+    if (topic) {
+        TopicEntry& cached = entry->topics[topic_name];
+        cached.topic = topic;
+        cached.type_name = type_name;
+        cached.refcount = 1;
+    }
+    return topic;
+}
+
+static void cardinal_release_topic(uint32_t domain_id, Topic* topic) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    auto pit = g_participants.find(domain_id);
+    if (pit == g_participants.end()) {
+        return;
+    }
+
+    ParticipantEntry& entry = pit->second;
+    for (auto it = entry.topics.begin(); it != entry.topics.end(); ++it) {
+        if (it->second.topic == topic) {
+            if (--it->second.refcount <= 0) {
+                entry.participant->delete_topic(topic);
+                entry.topics.erase(it);
+            }
+            return;
+        }
+    }
+}
+
+// Shared factory objects, reference-counted like topics. qos is only
+// consulted for the partition name; everything endpoint-specific lives on
+// the DataWriter/DataReader.
+static Publisher* cardinal_get_publisher(ParticipantEntry* entry, const CardinalQos* qos) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    std::string partition = (qos && qos->partition) ? qos->partition : "";
+    auto it = entry->publishers.find(partition);
+    if (it != entry->publishers.end()) {
+        it->second.second++;
+        return it->second.first;
+    }
+
+    PublisherQos publisher_qos = PUBLISHER_QOS_DEFAULT;
+    if (!partition.empty()) {
+        publisher_qos.partition().push_back(partition.c_str());
+    }
+    Publisher* publisher = entry->participant->create_publisher(publisher_qos);
+    if (publisher) {
+        entry->publishers.emplace(partition, std::make_pair(publisher, 1));
+    }
+    return publisher;
+}
+
+static void cardinal_release_publisher(uint32_t domain_id, Publisher* publisher) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    auto pit = g_participants.find(domain_id);
+    if (pit == g_participants.end()) {
+        return;
+    }
+
+    ParticipantEntry& entry = pit->second;
+    for (auto it = entry.publishers.begin(); it != entry.publishers.end(); ++it) {
+        if (it->second.first == publisher) {
+            if (--it->second.second <= 0) {
+                entry.participant->delete_publisher(publisher);
+                entry.publishers.erase(it);
+            }
+            return;
+        }
+    }
+}
+
+static Subscriber* cardinal_get_subscriber(ParticipantEntry* entry, const CardinalQos* qos) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    std::string partition = (qos && qos->partition) ? qos->partition : "";
+    auto it = entry->subscribers.find(partition);
+    if (it != entry->subscribers.end()) {
+        it->second.second++;
+        return it->second.first;
+    }
+
+    SubscriberQos subscriber_qos = SUBSCRIBER_QOS_DEFAULT;
+    if (!partition.empty()) {
+        subscriber_qos.partition().push_back(partition.c_str());
+    }
+    Subscriber* subscriber = entry->participant->create_subscriber(subscriber_qos);
+    if (subscriber) {
+        entry->subscribers.emplace(partition, std::make_pair(subscriber, 1));
+    }
+    return subscriber;
+}
+
+static void cardinal_release_subscriber(uint32_t domain_id, Subscriber* subscriber) {
+    std::lock_guard<std::mutex> lock(g_participant_mutex);
+
+    auto pit = g_participants.find(domain_id);
+    if (pit == g_participants.end()) {
+        return;
+    }
+
+    ParticipantEntry& entry = pit->second;
+    for (auto it = entry.subscribers.begin(); it != entry.subscribers.end(); ++it) {
+        if (it->second.first == subscriber) {
+            if (--it->second.second <= 0) {
+                entry.participant->delete_subscriber(subscriber);
+                entry.subscribers.erase(it);
+            }
+            return;
+        }
+    }
+}
+
+static Duration_t ms_to_duration(uint32_t ms) {
+    return Duration_t(static_cast<int32_t>(ms / 1000), (ms % 1000) * 1000000);
+}
+
+// Translate the CardinalQos knobs onto FastDDS endpoint QoS. Fields left at
+// their _DEFAULT/0 values keep whatever the FastDDS default profile says.
+static void apply_writer_qos(DataWriterQos& writer_qos, const CardinalQos* qos) {
+    if (!qos) {
+        return;
+    }
+    if (qos->reliability == CARDINAL_RELIABILITY_BEST_EFFORT) {
+        writer_qos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
+    } else if (qos->reliability == CARDINAL_RELIABILITY_RELIABLE) {
+        writer_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    }
+    if (qos->history_kind == CARDINAL_HISTORY_KEEP_LAST) {
+        writer_qos.history().kind = KEEP_LAST_HISTORY_QOS;
+        if (qos->history_depth > 0) {
+            writer_qos.history().depth = qos->history_depth;
+        }
+    } else if (qos->history_kind == CARDINAL_HISTORY_KEEP_ALL) {
+        writer_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+    }
+    if (qos->durability == CARDINAL_DURABILITY_VOLATILE) {
+        writer_qos.durability().kind = VOLATILE_DURABILITY_QOS;
+    } else if (qos->durability == CARDINAL_DURABILITY_TRANSIENT_LOCAL) {
+        writer_qos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+    }
+    if (qos->transport == CARDINAL_TRANSPORT_SHM) {
+        // Let matched same-host endpoints exchange samples via data-sharing
+        writer_qos.data_sharing().automatic();
+    }
+    if (qos->max_bytes_per_period > 0) {
+        // Pace this writer through the shared flow controller
+        writer_qos.publish_mode().kind = ASYNCHRONOUS_PUBLISH_MODE;
+        writer_qos.publish_mode().flow_controller_name = kFlowControllerName;
+    }
+    if (qos->deadline_ms > 0) {
+        writer_qos.deadline().period = ms_to_duration(qos->deadline_ms);
+    }
+    if (qos->liveliness_lease_ms > 0) {
+        writer_qos.liveliness().kind = AUTOMATIC_LIVELINESS_QOS;
+        writer_qos.liveliness().lease_duration = ms_to_duration(qos->liveliness_lease_ms);
+        // Announce well inside the lease so jitter does not fake a death
+        uint32_t announce_ms = qos->liveliness_lease_ms / 3;
+        writer_qos.liveliness().announcement_period = ms_to_duration(announce_ms > 0 ? announce_ms : 1);
+    }
+}
+
+static void apply_reader_qos(DataReaderQos& reader_qos, const CardinalQos* qos) {
+    if (!qos) {
+        return;
+    }
+    if (qos->reliability == CARDINAL_RELIABILITY_BEST_EFFORT) {
+        reader_qos.reliability().kind = BEST_EFFORT_RELIABILITY_QOS;
+    } else if (qos->reliability == CARDINAL_RELIABILITY_RELIABLE) {
+        reader_qos.reliability().kind = RELIABLE_RELIABILITY_QOS;
+    }
+    if (qos->history_kind == CARDINAL_HISTORY_KEEP_LAST) {
+        reader_qos.history().kind = KEEP_LAST_HISTORY_QOS;
+        if (qos->history_depth > 0) {
+            reader_qos.history().depth = qos->history_depth;
+        }
+    } else if (qos->history_kind == CARDINAL_HISTORY_KEEP_ALL) {
+        reader_qos.history().kind = KEEP_ALL_HISTORY_QOS;
+    }
+    if (qos->durability == CARDINAL_DURABILITY_VOLATILE) {
+        reader_qos.durability().kind = VOLATILE_DURABILITY_QOS;
+    } else if (qos->durability == CARDINAL_DURABILITY_TRANSIENT_LOCAL) {
+        reader_qos.durability().kind = TRANSIENT_LOCAL_DURABILITY_QOS;
+    }
+    if (qos->transport == CARDINAL_TRANSPORT_SHM) {
+        reader_qos.data_sharing().automatic();
+    }
+    if (qos->deadline_ms > 0) {
+        reader_qos.deadline().period = ms_to_duration(qos->deadline_ms);
+    }
+    if (qos->liveliness_lease_ms > 0) {
+        reader_qos.liveliness().kind = AUTOMATIC_LIVELINESS_QOS;
+        reader_qos.liveliness().lease_duration = ms_to_duration(qos->liveliness_lease_ms);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Hot-path counters. All updates use relaxed atomics: the dashboards reading
+// these care about trends, not about a memory-ordering-exact snapshot.
+// ---------------------------------------------------------------------------
+struct EndpointStats {
+    std::atomic<uint64_t> messages{0};
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> errors{0};
+    std::atomic<uint64_t> samples_lost{0};
+    std::atomic<uint64_t> write_latency_us[CARDINAL_LATENCY_BUCKETS];
+    std::atomic<int> last_error{0};
+
+    EndpointStats() {
+        for (auto& bucket : write_latency_us) {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static int latency_bucket(uint64_t us) {
+        int bucket = 0;
+        while (us >>= 1) {
+            bucket++;
+        }
+        return bucket < CARDINAL_LATENCY_BUCKETS ? bucket : CARDINAL_LATENCY_BUCKETS - 1;
+    }
+
+    void record_write(ReturnCode_t ret, uint64_t payload_bytes, uint64_t us) {
+        if (ret == RETCODE_OK) {
+            messages.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(payload_bytes, std::memory_order_relaxed);
+            write_latency_us[latency_bucket(us)].fetch_add(1, std::memory_order_relaxed);
+        } else {
+            errors.fetch_add(1, std::memory_order_relaxed);
+            last_error.store(static_cast<int>(ret), std::memory_order_relaxed);
+        }
+    }
+
+    void record_receive(uint64_t payload_bytes) {
+        messages.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(payload_bytes, std::memory_order_relaxed);
+    }
+
+    // Failed take/read on a subscriber. RETCODE_NO_DATA is just an empty
+    // reader, not an error, so callers can record every non-OK return.
+    void record_take(ReturnCode_t ret) {
+        if (ret != RETCODE_OK && ret != RETCODE_NO_DATA) {
+            errors.fetch_add(1, std::memory_order_relaxed);
+            last_error.store(static_cast<int>(ret), std::memory_order_relaxed);
+        }
+    }
+
+    void snapshot(CardinalStats* out) const {
+        out->messages = messages.load(std::memory_order_relaxed);
+        out->bytes = bytes.load(std::memory_order_relaxed);
+        out->errors = errors.load(std::memory_order_relaxed);
+        out->samples_lost = samples_lost.load(std::memory_order_relaxed);
+        for (int i = 0; i < CARDINAL_LATENCY_BUCKETS; ++i) {
+            out->write_latency_us[i] = write_latency_us[i].load(std::memory_order_relaxed);
+        }
+        out->last_error = last_error.load(std::memory_order_relaxed);
+    }
+};
+
+// Timed DataWriter::write() that feeds the latency histogram
+static ReturnCode_t timed_write(DataWriter* writer, const void* data, uint64_t payload_bytes, EndpointStats& stats) {
+    CARDINAL_TRACE_SPAN(CARDINAL_TRACE_WRITE);
+    auto start = std::chrono::steady_clock::now();
+    ReturnCode_t ret = writer->write(data);
+    uint64_t us = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+    stats.record_write(ret, payload_bytes, us);
+    return ret;
+}
+
+// ---------------------------------------------------------------------------
+// Async publish queue: lock-free SPSC ring between the FFI caller (producer)
+// and a dedicated drain thread (consumer) that feeds the DataWriter, so the
+// caller never blocks on reliable-QoS acknack round trips.
+// ---------------------------------------------------------------------------
+struct AsyncSlot {
+    std::string message;
+    int64_t timestamp = 0;
+    uint32_t key = 0;
+};
+
+struct AsyncPublishQueue {
+    static constexpr size_t kCapacity = 4096; // power of two
+
+    std::vector<AsyncSlot> slots{kCapacity};
+    std::atomic<size_t> head{0}; // next slot to drain
+    std::atomic<size_t> tail{0}; // next slot to fill
+    std::atomic<bool> stop{false};
+    std::thread drainer;
+
+    // Single producer only; returns false when the ring is full
+    bool push(const char* message, int64_t timestamp, uint32_t key) {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) >= kCapacity) {
+            return false;
+        }
+
+        AsyncSlot& slot = slots[t & (kCapacity - 1)];
+        slot.message.assign(message);
+        slot.timestamp = timestamp;
+        slot.key = key;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Crash-safe journal: a memory-mapped ring file the publish path appends to
+// with plain stores, so journaling costs no syscalls and everything written
+// before a crash is recoverable from the file. The data area is split into
+// two halves that fill alternately: when a record does not fit in the active
+// half, the writer switches to the other half and resets it. A single ring
+// that restarts at offset 0 would overwrite the start of the previous
+// generation on every wrap, leaving ~nothing to replay right after one; with
+// alternating halves the previous generation stays parseable in full, so
+// replay always sees at least the most recent capacity/2 of traffic.
+// ---------------------------------------------------------------------------
+static const char kJournalMagic[8] = {'C', 'R', 'D', 'J', 'R', 'N', 'L', '2'};
+
+struct JournalHeader {
+    char magic[8];
+    uint64_t capacity;      // data area size in bytes (each half is capacity/2)
+    uint64_t write_pos;     // monotonic byte count ever appended
+    uint64_t active_half;   // 0 or 1: the half currently being filled
+    uint64_t half_used[2];  // bytes of complete records in each half
+    uint64_t reserved[2];
+};
+
+struct JournalRecordHeader {
+    uint32_t length;     // message bytes following this header
+    uint32_t key;
+    int64_t timestamp;
+};
+
+struct Journal {
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t map_size = 0;
+    JournalHeader* header = nullptr;
+    uint8_t* data = nullptr;
+    std::mutex mutex;
+
+    ~Journal() {
+        if (base) {
+            msync(base, map_size, MS_ASYNC);
+            munmap(base, map_size);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+    }
+};
+
+static Journal* journal_open(const char* path, size_t size_bytes, bool writable) {
+    Journal* journal = new Journal();
+    journal->fd = open(path, writable ? (O_RDWR | O_CREAT) : O_RDONLY, 0644);
+    if (journal->fd < 0) {
+        std::cerr << "Failed to open journal file: " << path << std::endl;
+        delete journal;
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(journal->fd, &st) != 0) {
+        delete journal;
+        return nullptr;
+    }
+
+    size_t map_size = writable ? sizeof(JournalHeader) + size_bytes
+                               : static_cast<size_t>(st.st_size);
+    if (writable && static_cast<size_t>(st.st_size) != map_size) {
+        if (ftruncate(journal->fd, static_cast<off_t>(map_size)) != 0) {
+            std::cerr << "Failed to size journal file: " << path << std::endl;
+            delete journal;
+            return nullptr;
+        }
+    }
+    // Each half must at least fit one record header
+    if (map_size < sizeof(JournalHeader) + 2 * sizeof(JournalRecordHeader)) {
+        std::cerr << "Journal too small: " << path << std::endl;
+        delete journal;
+        return nullptr;
+    }
+
+    journal->base = static_cast<uint8_t*>(
+        mmap(nullptr, map_size, writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+             MAP_SHARED, journal->fd, 0));
+    if (journal->base == MAP_FAILED) {
+        journal->base = nullptr;
+        std::cerr << "Failed to mmap journal file: " << path << std::endl;
+        delete journal;
+        return nullptr;
+    }
+    journal->map_size = map_size;
+    journal->header = reinterpret_cast<JournalHeader*>(journal->base);
+    journal->data = journal->base + sizeof(JournalHeader);
+
+    if (memcmp(journal->header->magic, kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        if (!writable) {
+            std::cerr << "Not a cardinal journal: " << path << std::endl;
+            delete journal;
+            return nullptr;
+        }
+        // Fresh (or foreign) file: initialize the ring
+        memset(journal->base, 0, sizeof(JournalHeader));
+        memcpy(journal->header->magic, kJournalMagic, sizeof(kJournalMagic));
+        journal->header->capacity = map_size - sizeof(JournalHeader);
+        journal->header->write_pos = 0;
+    } else if (journal->header->capacity != map_size - sizeof(JournalHeader)) {
+        std::cerr << "Journal capacity mismatch: " << path << std::endl;
+        delete journal;
+        return nullptr;
+    } else if (journal->header->active_half > 1 ||
+               journal->header->half_used[0] > journal->header->capacity / 2 ||
+               journal->header->half_used[1] > journal->header->capacity / 2) {
+        std::cerr << "Corrupt journal header: " << path << std::endl;
+        delete journal;
+        return nullptr;
+    }
+
+    return journal;
+}
+
+static void journal_append(Journal* journal, const char* message, uint32_t key, int64_t timestamp) {
+    size_t length = strlen(message);
+    size_t record = sizeof(JournalRecordHeader) + length;
+    uint64_t half_capacity = journal->header->capacity / 2;
+    if (record > half_capacity) {
+        return; // message larger than a half, drop it
+    }
+
+    std::lock_guard<std::mutex> lock(journal->mutex);
+    uint64_t active = journal->header->active_half;
+    if (journal->header->half_used[active] + record > half_capacity) {
+        // Active half is full: switch to the other one and restart it. The
+        // half we leave behind keeps the previous generation intact, so a
+        // replay right after the switch still sees it. Resetting half_used
+        // before flipping active_half keeps a crash between the two stores
+        // consistent (the old half just stays active and full).
+        active ^= 1;
+        journal->header->half_used[active] = 0;
+        journal->header->active_half = active;
+    }
+
+    uint8_t* base = journal->data + active * half_capacity;
+    uint64_t offset = journal->header->half_used[active];
+    JournalRecordHeader record_header;
+    record_header.length = static_cast<uint32_t>(length);
+    record_header.key = key;
+    record_header.timestamp = timestamp;
+    memcpy(base + offset, &record_header, sizeof(record_header));
+    memcpy(base + offset + sizeof(record_header), message, length);
+    // The record is fully in place before half_used exposes it, so a crash
+    // mid-append at worst loses that one record
+    journal->header->half_used[active] = offset + record;
+    journal->header->write_pos += record;
+}
+
+// ---------------------------------------------------------------------------
+// MPSC publish queue: bounded lock-free multi-producer ring with per-slot
+// sequence numbers (Vyukov's bounded queue), drained by one consumer thread
+// into the DataWriter. Enqueues are wait-free unless two producers race for
+// the same slot, and each producer's messages keep the order in which it
+// claimed slots -- this replaces the contended mutex callers had to wrap
+// around publish_simple_message().
+// ---------------------------------------------------------------------------
+struct MpscSlot {
+    std::atomic<size_t> sequence{0};
+    std::string message;
+    int64_t timestamp = 0;
+    uint32_t key = 0;
+};
+
+struct MpscPublishQueue {
+    static constexpr size_t kCapacity = 4096; // power of two
+
+    std::vector<MpscSlot> slots{kCapacity};
+    std::atomic<size_t> enqueue_pos{0};
+    std::atomic<size_t> dequeue_pos{0};
+    std::atomic<bool> stop{false};
+    std::thread drainer;
+
+    MpscPublishQueue() {
+        for (size_t i = 0; i < kCapacity; ++i) {
+            slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(const char* message, int64_t timestamp, uint32_t key) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        MpscSlot* slot;
+        for (;;) {
+            slot = &slots[pos & (kCapacity - 1)];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                // Slot is free for this ticket; claim it
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // ring full
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        slot->message.assign(message);
+        slot->timestamp = timestamp;
+        slot->key = key;
+        // Publishing sequence = ticket + 1 hands the slot to the consumer
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Single consumer only (the drain thread)
+    bool pop(SimpleMessageData& out) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        MpscSlot* slot = &slots[pos & (kCapacity - 1)];
+        size_t seq = slot->sequence.load(std::memory_order_acquire);
+        if (static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1) < 0) {
+            return false; // nothing published at this position yet
+        }
+
+        out.message.swap(slot->message);
+        out.timestamp = slot->timestamp;
+        out.key = slot->key;
+        // Recycle the slot for the producer one lap ahead
+        slot->sequence.store(pos + kCapacity, std::memory_order_release);
+        dequeue_pos.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+};
+
+// Publisher wrapper
+struct SimplePublisherWrapper {
+    DomainParticipant* participant;
+    Publisher* publisher;
+    Topic* topic;
+    DataWriter* writer;
+    TypeSupport type_support;
+    uint32_t domain_id = 0;
+    std::unique_ptr<AsyncPublishQueue> async; // set for async publishers only
+    std::unique_ptr<MpscPublishQueue> mpsc;   // set for thread-safe publishers only
+    std::unique_ptr<Journal> journal;         // set by publisher_attach_journal()
+    EndpointStats stats;
+};
+
+static void async_drain_loop(SimplePublisherWrapper* wrapper) {
+    AsyncPublishQueue* queue = wrapper->async.get();
+    SimpleMessageData msg_data;
+
+    while (true) {
+        size_t head = queue->head.load(std::memory_order_relaxed);
+        if (head == queue->tail.load(std::memory_order_acquire)) {
+            if (queue->stop.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+
+        // Move the slot contents out before publishing the new head, so the
+        // producer can never overwrite a slot we are still reading
+        AsyncSlot& slot = queue->slots[head & (AsyncPublishQueue::kCapacity - 1)];
+        msg_data.message.swap(slot.message);
+        msg_data.timestamp = slot.timestamp;
+        msg_data.key = slot.key;
+        queue->head.store(head + 1, std::memory_order_release);
+
+        if (timed_write(wrapper->writer, &msg_data, msg_data.message.length(), wrapper->stats) != RETCODE_OK) {
+            std::cerr << "Async write failed, dropping message" << std::endl;
+        }
+    }
+}
+
+static void mpsc_drain_loop(SimplePublisherWrapper* wrapper) {
+    MpscPublishQueue* queue = wrapper->mpsc.get();
+    SimpleMessageData msg_data;
+
+    while (true) {
+        if (!queue->pop(msg_data)) {
+            if (queue->stop.load(std::memory_order_acquire)) {
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            continue;
+        }
+
+        if (timed_write(wrapper->writer, &msg_data, msg_data.message.length(), wrapper->stats) != RETCODE_OK) {
+            std::cerr << "MPSC write failed, dropping message" << std::endl;
+        }
+    }
+}
+
+// Reader listener that converts samples and hands them straight to the
+// registered callback, replacing the polling loop on the language side
+class CallbackReaderListener : public DataReaderListener {
+public:
+    void on_data_available(DataReader* reader) override {
+        SimpleMessageCallback cb = callback.load(std::memory_order_acquire);
+        if (!cb) {
+            return;
+        }
+
+        SampleInfo info;
+        SimpleMessageData msg_data;
+        SimpleMessage msg;
+
+        while (reader->take_next_sample(&msg_data, &info) == RETCODE_OK) {
+            if (!info.valid_data) {
+                continue;
+            }
+            strncpy(msg.message, msg_data.message.c_str(), 255);
+            msg.message[255] = '\0';
+            msg.timestamp = msg_data.timestamp;
+            msg.key = msg_data.key;
+            if (stats) {
+                stats->record_receive(msg_data.message.length());
+            }
+            cb(&msg, context.load(std::memory_order_acquire));
+        }
+    }
+
+    void on_sample_lost(DataReader* reader, const SampleLostStatus& status) override {
+        if (stats && status.total_count_change > 0) {
+            stats->samples_lost.fetch_add(static_cast<uint64_t>(status.total_count_change),
+                                          std::memory_order_relaxed);
+        }
+    }
+
+    void on_liveliness_changed(DataReader* reader, const LivelinessChangedStatus& status) override {
+        alive_count.store(status.alive_count, std::memory_order_relaxed);
+        not_alive_count.store(status.not_alive_count, std::memory_order_relaxed);
+        change_events.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void on_requested_deadline_missed(DataReader* reader, const RequestedDeadlineMissedStatus& status) override {
+        if (status.total_count_change > 0) {
+            missed_deadlines.fetch_add(static_cast<uint64_t>(status.total_count_change),
+                                       std::memory_order_relaxed);
+        }
+    }
+
+    std::atomic<SimpleMessageCallback> callback{nullptr};
+    std::atomic<void*> context{nullptr};
+    EndpointStats* stats = nullptr;
+    // Liveliness/deadline counters (see get_liveliness_changed)
+    std::atomic<int32_t> alive_count{0};
+    std::atomic<int32_t> not_alive_count{0};
+    std::atomic<uint64_t> change_events{0};
+    std::atomic<uint64_t> missed_deadlines{0};
+};
+
+// Statuses the listener watches even before any message callback is set:
+// lost samples, liveliness transitions, and missed deadlines
+static StatusMask monitor_status_mask() {
+    return StatusMask::sample_lost() | StatusMask::liveliness_changed() |
+           StatusMask::requested_deadline_missed();
+}
+
+// Reader listener that folds CardinalSamples into a windowed digest on the
+// listener thread, so consumers pull one digest per window instead of every
+// sample (see enable_aggregation)
+class SampleAggregator : public DataReaderListener {
+public:
+    SampleAggregator(EndpointStats* stats, uint32_t window_ms)
+        : stats_(stats), window_ms_(window_ms) {}
+
+    void on_data_available(DataReader* reader) override {
+        LoanableSequence<CardinalSample> samples;
+        SampleInfoSeq infos;
+        if (reader->take(samples, infos) != RETCODE_OK) {
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        roll_window(now_ms());
+        // Tight fold over the loaned contiguous samples; no copies out
+        for (int32_t i = 0; i < samples.length(); ++i) {
+            if (!infos[i].valid_data) {
+                continue;
+            }
+            const CardinalSample& sample = samples[i];
+            if (current_.count == 0) {
+                current_.min = current_.max = sample.value;
+                current_.first_timestamp = sample.timestamp;
+            } else {
+                if (sample.value < current_.min) current_.min = sample.value;
+                if (sample.value > current_.max) current_.max = sample.value;
+            }
+            current_.sum += sample.value;
+            current_.last = sample.value;
+            current_.last_timestamp = sample.timestamp;
+            current_.count++;
+            stats_->record_receive(sizeof(CardinalSample));
+        }
+        reader->return_loan(samples, infos);
+    }
+
+    void on_sample_lost(DataReader* reader, const SampleLostStatus& status) override {
+        if (stats_ && status.total_count_change > 0) {
+            stats_->samples_lost.fetch_add(static_cast<uint64_t>(status.total_count_change),
+                                           std::memory_order_relaxed);
+        }
+    }
+
+    void read(CardinalWindowStats* out) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (window_ms_ == 0) {
+            // Free-running mode: hand over whatever accumulated since last read
+            copy_out(current_, out);
+            current_ = CardinalWindowStats{};
+            return;
+        }
+        roll_window(now_ms());
+        copy_out(completed_, out);
+    }
+
+private:
+    static int64_t now_ms() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static void copy_out(const CardinalWindowStats& digest, CardinalWindowStats* out) {
+        *out = digest;
+    }
+
+    // Close the current window once it is older than window_ms
+    void roll_window(int64_t now) {
+        if (window_ms_ == 0) {
+            return;
+        }
+        if (window_start_ms_ == 0) {
+            window_start_ms_ = now;
+        } else if (now - window_start_ms_ >= static_cast<int64_t>(window_ms_)) {
+            completed_ = current_;
+            current_ = CardinalWindowStats{};
+            window_start_ms_ = now;
+        }
+    }
+
+    EndpointStats* stats_;
+    uint32_t window_ms_;
+    std::mutex mutex_;
+    int64_t window_start_ms_ = 0;
+    CardinalWindowStats current_{};
+    CardinalWindowStats completed_{};
+};
+
+// Subscriber wrapper
+struct SimpleSubscriberWrapper {
+    DomainParticipant* participant;
+    Subscriber* subscriber;
+    Topic* topic;
+    DataReader* reader;
+    TypeSupport type_support;
+    uint32_t domain_id = 0;
+    ContentFilteredTopic* filtered_topic = nullptr; // set for filtered subscribers
+    std::unique_ptr<CallbackReaderListener> listener; // set by set_message_callback
+    std::unique_ptr<SampleAggregator> aggregator;     // set by enable_aggregation
+    EndpointStats stats;
+    // Intra-process bypass: queue fed directly by same-process publishers
+    // when cardinal_set_intraprocess() is enabled
+    std::string topic_name;
+    std::mutex bypass_mutex;
+    std::deque<SimpleMessageData> bypass_queue;
+    // Loan bookkeeping for receive_loan/return_loan (one loan at a time)
+    LoanableSequence<SimpleMessageData> loan_samples;
+    SampleInfoSeq loan_infos;
+    bool loan_active = false;
+    SimpleMessageData loan_bypass;   // holds a bypassed message while loaned out
+    bool loan_from_bypass = false;
+};
+
+// ---------------------------------------------------------------------------
+// Intra-process bypass: same-process subscribers on a topic get publishes
+// handed across directly -- via their callback or an in-memory queue --
+// skipping serialization and the RTPS stack. Opt-in and process-local only.
+// ---------------------------------------------------------------------------
+static constexpr size_t kBypassQueueLimit = 4096;
+
+static std::atomic<bool> g_intraprocess_enabled{false};
+static std::mutex g_local_subs_mutex;
+static std::multimap<std::string, SimpleSubscriberWrapper*> g_local_subs;
+
+static void register_local_subscriber(SimpleSubscriberWrapper* wrapper, const char* topic_name) {
+    wrapper->topic_name = topic_name;
+    std::lock_guard<std::mutex> lock(g_local_subs_mutex);
+    g_local_subs.emplace(wrapper->topic_name, wrapper);
+}
+
+static void unregister_local_subscriber(SimpleSubscriberWrapper* wrapper) {
+    if (wrapper->topic_name.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_local_subs_mutex);
+    auto range = g_local_subs.equal_range(wrapper->topic_name);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == wrapper) {
+            g_local_subs.erase(it);
+            break;
+        }
+    }
+}
+
+// Returns true when the message was delivered in-process (so the caller must
+// not also hand it to the DataWriter)
+static bool try_intraprocess_publish(SimplePublisherWrapper* wrapper, const char* message,
+                                     int64_t timestamp, uint32_t key) {
+    if (!g_intraprocess_enabled.load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    // Snapshot the matching subscribers and deliver outside the registry
+    // lock: a callback may publish again (re-entering this function) or
+    // destroy a subscriber, and holding the lock across user code would
+    // deadlock it -- and serialize every publisher in the process meanwhile.
+    // Destroying a subscriber from another thread mid-publish remains the
+    // caller's race to avoid, as with any DDS entity. The vector is borrowed
+    // from a thread-local so the steady state stays allocation-free while
+    // nested deliveries still get their own storage.
+    static thread_local std::vector<SimpleSubscriberWrapper*> t_match_pool;
+    std::vector<SimpleSubscriberWrapper*> matches = std::move(t_match_pool);
+    matches.clear();
+    {
+        std::lock_guard<std::mutex> lock(g_local_subs_mutex);
+        auto range = g_local_subs.equal_range(wrapper->topic->get_name());
+        for (auto it = range.first; it != range.second; ++it) {
+            matches.push_back(it->second);
+        }
+    }
+    if (matches.empty()) {
+        t_match_pool = std::move(matches);
+        return false; // No local subscribers, take the normal DDS path
+    }
+
+    size_t length = strlen(message);
+    for (SimpleSubscriberWrapper* sub : matches) {
+        // Callback subscribers get the message synchronously, no queue hop
+        SimpleMessageCallback cb = sub->listener
+            ? sub->listener->callback.load(std::memory_order_acquire) : nullptr;
+        if (cb) {
+            SimpleMessage msg;
+            strncpy(msg.message, message, 255);
+            msg.message[255] = '\0';
+            msg.timestamp = timestamp;
+            msg.key = key;
+            sub->stats.record_receive(length);
+            cb(&msg, sub->listener->context.load(std::memory_order_acquire));
+            continue;
+        }
+
+        std::lock_guard<std::mutex> sub_lock(sub->bypass_mutex);
+        if (sub->bypass_queue.size() >= kBypassQueueLimit) {
+            sub->stats.samples_lost.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        sub->bypass_queue.emplace_back();
+        SimpleMessageData& queued = sub->bypass_queue.back();
+        queued.message.assign(message);
+        queued.timestamp = timestamp;
+        queued.key = key;
+    }
+
+    t_match_pool = std::move(matches);
+    wrapper->stats.record_write(RETCODE_OK, length, 0);
+    return true;
+}
+
+// Pops one bypassed message, if any
+static bool bypass_pop(SimpleSubscriberWrapper* wrapper, SimpleMessageData& out) {
+    std::lock_guard<std::mutex> lock(wrapper->bypass_mutex);
+    if (wrapper->bypass_queue.empty()) {
+        return false;
+    }
+    out = std::move(wrapper->bypass_queue.front());
+    wrapper->bypass_queue.pop_front();
+    return true;
+}
+
+// Multiplexer: one WaitSet servicing many readers, so a single blocked
+// thread replaces a polling loop per topic
+struct MuxEntry {
+    StatusCondition* condition = nullptr;
+    int tag = 0;
+};
+
+struct CardinalMuxWrapper {
+    WaitSet waitset;
+    std::vector<MuxEntry> entries;
+    std::mutex mutex;
+};
+
+// Reader listener that hands bridged samples straight to the destination
+// writer on the middleware thread (see create_bridge). The holder carries
+// raw serialized bytes, so the forward is copy-in, copy-out -- no decode.
+class BridgeForwarder : public DataReaderListener {
+public:
+    void on_data_available(DataReader* reader) override {
+        SampleInfo info;
+        while (reader->take_next_sample(&holder_, &info) == RETCODE_OK) {
+            if (!info.valid_data) {
+                continue;
+            }
+            timed_write(writer, &holder_, holder_.bytes.size(), *stats);
+        }
+    }
+
+    void on_sample_lost(DataReader* reader, const SampleLostStatus& status) override {
+        if (stats && status.total_count_change > 0) {
+            stats->samples_lost.fetch_add(static_cast<uint64_t>(status.total_count_change),
+                                          std::memory_order_relaxed);
+        }
+    }
+
+    DataWriter* writer = nullptr;
+    EndpointStats* stats = nullptr;
+
+private:
+    RawSampleData holder_; // reused across samples; listener calls are serialized
+};
+
+// Bridge wrapper: one subscriber on the source domain, one publisher on the
+// destination domain, tied together by a BridgeForwarder. The bridge owns
+// dedicated participants -- the pooled ones already register the real
+// "SimpleMessage" type, and a participant cannot carry two types of the same
+// name.
+struct CardinalBridgeWrapper {
+    DomainParticipant* src_participant = nullptr;
+    DomainParticipant* dst_participant = nullptr;
+    TypeSupport src_type;
+    TypeSupport dst_type;
+    Topic* src_topic = nullptr;
+    Topic* dst_topic = nullptr;
+    Subscriber* subscriber = nullptr;
+    Publisher* publisher = nullptr;
+    DataReader* reader = nullptr;
+    DataWriter* writer = nullptr;
+    std::unique_ptr<BridgeForwarder> forwarder;
+    EndpointStats stats;
+};
+
+extern "C" {
+
+void cardinal_set_intraprocess(int enable) {
+    g_intraprocess_enabled.store(enable != 0, std::memory_order_relaxed);
+}
+
+CardinalQos cardinal_default_qos(void) {
+    CardinalQos qos;
+    memset(&qos, 0, sizeof(qos));
+    return qos;
+}
+
+SimpleDDSPublisher create_simple_publisher(const char* topic_name) {
+    return create_simple_publisher_with_qos(topic_name, nullptr);
+}
+
+SimpleDDSPublisher create_simple_publisher_with_qos(const char* topic_name, const CardinalQos* qos) {
+    try {
+        // Create wrapper
+        SimplePublisherWrapper* wrapper = new SimplePublisherWrapper();
+        wrapper->domain_id = 0;
+
+        // Acquire the shared participant for this domain (type already registered)
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, qos);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
+            delete wrapper;
+            return nullptr;
+        }
+        wrapper->participant = entry->participant;
+        // V2 endpoints live on the "SimpleMessageV2" topic type, so a topic
+        // carries exactly one wire format and mixed endpoints never match
+        wrapper->type_support = (qos && qos->wire_format == CARDINAL_WIRE_FORMAT_V2)
+            ? entry->v2_type_support : entry->type_support;
+
+        // Acquire the shared topic
+        wrapper->topic = cardinal_get_topic(entry, topic_name, wrapper->type_support.get_type_name());
+        if (!wrapper->topic) {
+            std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Acquire the shared publisher factory (scoped to the partition, if any)
+        wrapper->publisher = cardinal_get_publisher(entry, qos);
+        if (!wrapper->publisher) {
+            std::cerr << "Failed to create publisher" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Create writer
+        DataWriterQos writer_qos = DATAWRITER_QOS_DEFAULT;
+        apply_writer_qos(writer_qos, qos);
+        wrapper->writer = wrapper->publisher->create_datawriter(wrapper->topic, writer_qos);
+        if (!wrapper->writer) {
+            std::cerr << "Failed to create writer" << std::endl;
+            cardinal_release_publisher(wrapper->domain_id, wrapper->publisher);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_simple_publisher_with_qos: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+SimpleDDSPublisher create_simple_publisher_async(const char* topic_name) {
+    SimplePublisherWrapper* wrapper =
+        static_cast<SimplePublisherWrapper*>(create_simple_publisher(topic_name));
+    if (!wrapper) {
+        return nullptr;
+    }
+
+    wrapper->async.reset(new AsyncPublishQueue());
+    wrapper->async->drainer = std::thread(async_drain_loop, wrapper);
+    return wrapper;
+}
+
+SimpleDDSPublisher create_simple_publisher_mpsc(const char* topic_name) {
+    SimplePublisherWrapper* wrapper =
+        static_cast<SimplePublisherWrapper*>(create_simple_publisher(topic_name));
+    if (!wrapper) {
+        return nullptr;
+    }
+
+    wrapper->mpsc.reset(new MpscPublishQueue());
+    wrapper->mpsc->drainer = std::thread(mpsc_drain_loop, wrapper);
+    return wrapper;
+}
+
+int publish_simple_message(SimpleDDSPublisher pub, const char* message, long timestamp) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !wrapper->writer) {
+        return -1;
+    }
+
+    try {
+        if (wrapper->journal) {
+            journal_append(wrapper->journal.get(), message, 0, timestamp);
+        }
+
+        // Same-process subscribers get the message without serialization
+        if (try_intraprocess_publish(wrapper, message, timestamp, 0)) {
+            return 0;
+        }
+
+        // MPSC mode: wait-free push, safe from any thread
+        if (wrapper->mpsc) {
+            return wrapper->mpsc->push(message, timestamp, 0) ? 0 : -1;
+        }
+
+        // Async mode: push into the ring and return immediately
+        if (wrapper->async) {
+            return wrapper->async->push(message, timestamp, 0) ? 0 : -1;
+        }
+
+        // Pooled sample: assign() reuses its string capacity from earlier publishes
+        SimpleMessageData* msg_data = acquire_sample();
+        msg_data->message.assign(message);
+        msg_data->timestamp = timestamp;
+        msg_data->key = 0;
+        ReturnCode_t ret = timed_write(wrapper->writer, msg_data, msg_data->message.length(), wrapper->stats);
+        release_sample(msg_data);
+        return ret == RETCODE_OK ? 0 : -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publish_simple_message: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int publish_simple_message_keyed(SimpleDDSPublisher pub, unsigned int key, const char* message, long timestamp) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !wrapper->writer) {
+        return -1;
+    }
+
+    try {
+        if (wrapper->journal) {
+            journal_append(wrapper->journal.get(), message, key, timestamp);
+        }
+
+        if (try_intraprocess_publish(wrapper, message, timestamp, key)) {
+            return 0;
+        }
+
+        if (wrapper->mpsc) {
+            return wrapper->mpsc->push(message, timestamp, key) ? 0 : -1;
+        }
+
+        // Async handles must also go through the ring: writing here on the
+        // caller thread would race the drain thread and reorder samples
+        if (wrapper->async) {
+            return wrapper->async->push(message, timestamp, key) ? 0 : -1;
+        }
+
+        SimpleMessageData* msg_data = acquire_sample();
+        msg_data->message.assign(message);
+        msg_data->timestamp = timestamp;
+        msg_data->key = key;
+        ReturnCode_t ret = timed_write(wrapper->writer, msg_data, msg_data->message.length(), wrapper->stats);
+        release_sample(msg_data);
+        return ret == RETCODE_OK ? 0 : -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publish_simple_message_keyed: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int get_publisher_stats(SimpleDDSPublisher pub, CardinalStats* stats) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !stats) {
+        return -1;
+    }
+    wrapper->stats.snapshot(stats);
+    return 0;
+}
+
+int cardinal_set_trace_callback(CardinalTraceCallback cb, void* ctx) {
+#ifdef CARDINAL_TRACE_ENABLED
+    g_trace_context.store(ctx, std::memory_order_release);
+    g_trace_callback.store(cb, std::memory_order_release);
+    return 0;
+#else
+    (void)cb;
+    (void)ctx;
+    return -1; // built without -Dtrace=true
+#endif
+}
+
+int get_subscriber_stats(SimpleDDSSubscriber sub, CardinalStats* stats) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !stats) {
+        return -1;
+    }
+    wrapper->stats.snapshot(stats);
+    return 0;
+}
+
+size_t publisher_pending_count(SimpleDDSPublisher pub) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper) {
+        return 0;
+    }
+
+    if (wrapper->mpsc) {
+        MpscPublishQueue* queue = wrapper->mpsc.get();
+        return queue->enqueue_pos.load(std::memory_order_acquire) -
+               queue->dequeue_pos.load(std::memory_order_acquire);
+    }
+    if (wrapper->async) {
+        AsyncPublishQueue* queue = wrapper->async.get();
+        return queue->tail.load(std::memory_order_acquire) - queue->head.load(std::memory_order_acquire);
+    }
+    return 0;
+}
+
+int publish_simple_messages_batch(SimpleDDSPublisher pub, const SimpleMessage* msgs, size_t count) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !wrapper->writer || !msgs) {
+        return -1;
+    }
+
+    try {
+        // Reuse one sample across the loop so the string buffer is recycled
+        // instead of reallocated per message
+        SimpleMessageData msg_data;
+        size_t written = 0;
+
+        for (size_t i = 0; i < count; ++i) {
+            if (wrapper->journal) {
+                journal_append(wrapper->journal.get(), msgs[i].message, msgs[i].key, msgs[i].timestamp);
+            }
+
+            if (try_intraprocess_publish(wrapper, msgs[i].message, msgs[i].timestamp, msgs[i].key)) {
+                written++;
+                continue;
+            }
+
+            if (wrapper->mpsc) {
+                if (!wrapper->mpsc->push(msgs[i].message, msgs[i].timestamp, msgs[i].key)) {
+                    break; // ring full
+                }
+                written++;
+                continue;
+            }
+
+            if (wrapper->async) {
+                if (!wrapper->async->push(msgs[i].message, msgs[i].timestamp, msgs[i].key)) {
+                    break; // ring full
+                }
+                written++;
+                continue;
+            }
+
+            msg_data.message.assign(msgs[i].message);
+            msg_data.timestamp = msgs[i].timestamp;
+            msg_data.key = msgs[i].key;
+
+            if (timed_write(wrapper->writer, &msg_data, msg_data.message.length(), wrapper->stats) != RETCODE_OK) {
+                break;
+            }
+            written++;
+        }
+
+        return static_cast<int>(written);
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publish_simple_messages_batch: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int publisher_attach_journal(SimpleDDSPublisher pub, const char* path, size_t size_bytes) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !path || size_bytes == 0) {
+        return -1;
+    }
+
+    try {
+        Journal* journal = journal_open(path, size_bytes, true);
+        if (!journal) {
+            return -1;
+        }
+        wrapper->journal.reset(journal);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publisher_attach_journal: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+long replay_journal(const char* path, long from_timestamp, SimpleMessageCallback cb, void* ctx) {
+    if (!path || !cb) {
+        return -1;
+    }
+
+    try {
+        std::unique_ptr<Journal> journal(journal_open(path, 0, false));
+        if (!journal) {
+            return -1;
+        }
+
+        uint64_t half_capacity = journal->header->capacity / 2;
+        uint64_t active = journal->header->active_half;
+
+        // The inactive half holds the previous generation (older records),
+        // the active half the current one; walking them in that order keeps
+        // publish order across the last switch
+        long replayed = 0;
+        SimpleMessage msg;
+        for (int pass = 0; pass < 2; ++pass) {
+            uint64_t half = pass == 0 ? active ^ 1 : active;
+            const uint8_t* base = journal->data + half * half_capacity;
+            uint64_t used = journal->header->half_used[half];
+
+            uint64_t offset = 0;
+            while (offset + sizeof(JournalRecordHeader) <= used) {
+                JournalRecordHeader record_header;
+                memcpy(&record_header, base + offset, sizeof(record_header));
+                if (offset + sizeof(record_header) + record_header.length > used) {
+                    break; // torn tail record
+                }
+
+                offset += sizeof(record_header);
+                if (record_header.timestamp >= from_timestamp) {
+                    // Replay hands records out through SimpleMessage, whose
+                    // fixed buffer caps the replayed text at 255 bytes; the
+                    // journal itself stores the full message
+                    size_t copy_len = record_header.length < sizeof(msg.message) - 1
+                                          ? record_header.length
+                                          : sizeof(msg.message) - 1;
+                    memcpy(msg.message, base + offset, copy_len);
+                    msg.message[copy_len] = '\0';
+                    msg.timestamp = static_cast<long>(record_header.timestamp);
+                    msg.key = record_header.key;
+                    cb(&msg, ctx);
+                    replayed++;
+                }
+                offset += record_header.length;
+            }
+        }
+
+        return replayed;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in replay_journal: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+void destroy_simple_publisher(SimpleDDSPublisher pub) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (wrapper) {
+        // Stop the drain thread (it empties the ring) before tearing down the writer
+        if (wrapper->async) {
+            wrapper->async->stop.store(true, std::memory_order_release);
+            if (wrapper->async->drainer.joinable()) {
+                wrapper->async->drainer.join();
+            }
+        }
+        if (wrapper->mpsc) {
+            wrapper->mpsc->stop.store(true, std::memory_order_release);
+            if (wrapper->mpsc->drainer.joinable()) {
+                wrapper->mpsc->drainer.join();
+            }
+        }
+        if (wrapper->writer) wrapper->publisher->delete_datawriter(wrapper->writer);
+        if (wrapper->publisher) cardinal_release_publisher(wrapper->domain_id, wrapper->publisher);
+        if (wrapper->topic) cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+        if (wrapper->participant) cardinal_release_participant(wrapper->domain_id);
+        delete wrapper;
+    }
+}
+
+SimpleDDSSubscriber create_simple_subscriber(const char* topic_name) {
+    return create_simple_subscriber_with_qos(topic_name, nullptr);
+}
+
+SimpleDDSSubscriber create_simple_subscriber_with_qos(const char* topic_name, const CardinalQos* qos) {
+    try {
+        // Create wrapper
+        SimpleSubscriberWrapper* wrapper = new SimpleSubscriberWrapper();
+        wrapper->domain_id = 0;
+
+        // Acquire the shared participant for this domain (type already registered)
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, qos);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
+            delete wrapper;
+            return nullptr;
+        }
+        wrapper->participant = entry->participant;
+        // V2 endpoints live on the "SimpleMessageV2" topic type, so a topic
+        // carries exactly one wire format and mixed endpoints never match
+        wrapper->type_support = (qos && qos->wire_format == CARDINAL_WIRE_FORMAT_V2)
+            ? entry->v2_type_support : entry->type_support;
+
+        // Acquire the shared topic
+        wrapper->topic = cardinal_get_topic(entry, topic_name, wrapper->type_support.get_type_name());
+        if (!wrapper->topic) {
+            std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Acquire the shared subscriber factory (scoped to the partition, if any)
+        wrapper->subscriber = cardinal_get_subscriber(entry, qos);
+        if (!wrapper->subscriber) {
+            std::cerr << "Failed to create subscriber" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Create reader
+        DataReaderQos reader_qos = DATAREADER_QOS_DEFAULT;
+        apply_reader_qos(reader_qos, qos);
+        wrapper->reader = wrapper->subscriber->create_datareader(wrapper->topic, reader_qos);
+        if (!wrapper->reader) {
+            std::cerr << "Failed to create reader" << std::endl;
+            cardinal_release_subscriber(wrapper->domain_id, wrapper->subscriber);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Always-on monitor: counts lost samples, liveliness transitions, and
+        // missed deadlines from the moment the reader exists
+        wrapper->listener.reset(new CallbackReaderListener());
+        wrapper->listener->stats = &wrapper->stats;
+        wrapper->reader->set_listener(wrapper->listener.get(), monitor_status_mask());
+
+        // Make the subscriber reachable for the intra-process bypass
+        register_local_subscriber(wrapper, topic_name);
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_simple_subscriber_with_qos: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+int receive_simple_message(SimpleDDSSubscriber sub, SimpleMessage* msg) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader) {
+        return -1;
+    }
+
+    try {
+        SampleInfo info;
+        SimpleMessageData msg_data;
+
+        // Bypassed same-process messages first
+        if (bypass_pop(wrapper, msg_data)) {
+            strncpy(msg->message, msg_data.message.c_str(), 255);
+            msg->message[255] = '\0';
+            msg->timestamp = msg_data.timestamp;
+            msg->key = msg_data.key;
+            wrapper->stats.record_receive(msg_data.message.length());
+            return 0;
+        }
+
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_TAKE);
+        ReturnCode_t ret = wrapper->reader->read_next_sample(&msg_data, &info);
+        if (ret == RETCODE_OK) {
+            strncpy(msg->message, msg_data.message.c_str(), 255);
+            msg->message[255] = '\0';
+            msg->timestamp = msg_data.timestamp;
+            msg->key = msg_data.key;
+            wrapper->stats.record_receive(msg_data.message.length());
+            return 0;
+        }
+        wrapper->stats.record_take(ret);
+        return -1; // No data available
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_simple_message: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+SimpleDDSSubscriber create_filtered_subscriber(const char* topic_name, const char* filter_expression) {
+    if (!filter_expression) {
+        return create_simple_subscriber(topic_name);
+    }
+
+    try {
+        SimpleSubscriberWrapper* wrapper = new SimpleSubscriberWrapper();
+        wrapper->domain_id = 0;
+
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, nullptr);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
+            delete wrapper;
+            return nullptr;
+        }
+        wrapper->participant = entry->participant;
+        wrapper->type_support = entry->type_support;
+
+        wrapper->topic = cardinal_get_topic(entry, topic_name, entry->type_support.get_type_name());
+        if (!wrapper->topic) {
+            std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // Filtered-topic names must be unique per participant
+        static std::atomic<uint64_t> filter_counter{0};
+        std::string filtered_name = std::string(topic_name) + "__filtered_" +
+            std::to_string(filter_counter.fetch_add(1));
+
+        // The builtin DDSSQL filter class needs a TypeObject that the
+        // hand-rolled types do not register, so the wrapper's own filter
+        // class does the matching (see SimpleMessageContentFilter)
+        wrapper->filtered_topic = wrapper->participant->create_contentfilteredtopic(
+            filtered_name, wrapper->topic, filter_expression, std::vector<std::string>(),
+            kCardinalFilterClass);
+        if (!wrapper->filtered_topic) {
+            std::cerr << "Failed to create filtered topic (expression: " << filter_expression
+                      << "); see fastdds.h for the supported grammar" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->subscriber = cardinal_get_subscriber(entry, nullptr);
+        if (!wrapper->subscriber) {
+            std::cerr << "Failed to create subscriber" << std::endl;
+            wrapper->participant->delete_contentfilteredtopic(wrapper->filtered_topic);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        // The reader subscribes to the filtered view, so non-matching samples
+        // are rejected inside the middleware before deserialization
+        wrapper->reader = wrapper->subscriber->create_datareader(wrapper->filtered_topic, DATAREADER_QOS_DEFAULT);
+        if (!wrapper->reader) {
+            std::cerr << "Failed to create reader" << std::endl;
+            cardinal_release_subscriber(wrapper->domain_id, wrapper->subscriber);
+            wrapper->participant->delete_contentfilteredtopic(wrapper->filtered_topic);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->listener.reset(new CallbackReaderListener());
+        wrapper->listener->stats = &wrapper->stats;
+        wrapper->reader->set_listener(wrapper->listener.get(), monitor_status_mask());
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_filtered_subscriber: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+int set_message_callback(SimpleDDSSubscriber sub, SimpleMessageCallback cb, void* ctx) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader) {
+        return -1;
+    }
+
+    try {
+        if (!cb) {
+            // Unregister and return the reader to polling mode; the listener
+            // stays installed for the monitor statuses
+            if (wrapper->listener) {
+                wrapper->listener->callback.store(nullptr, std::memory_order_release);
+                wrapper->reader->set_listener(wrapper->listener.get(), monitor_status_mask());
+            }
+            return 0;
+        }
+
+        if (!wrapper->listener) {
+            wrapper->listener.reset(new CallbackReaderListener());
+            wrapper->listener->stats = &wrapper->stats;
+        }
+        wrapper->listener->context.store(ctx, std::memory_order_release);
+        wrapper->listener->callback.store(cb, std::memory_order_release);
+
+        return wrapper->reader->set_listener(wrapper->listener.get(),
+                                             monitor_status_mask() | StatusMask::data_available()) == RETCODE_OK
+            ? 0 : -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in set_message_callback: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int receive_simple_message_timed(SimpleDDSSubscriber sub, SimpleMessage* msg, int timeout_ms) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !msg) {
+        return CARDINAL_RECV_ERROR;
+    }
+
+    try {
+        SimpleMessageData msg_data;
+
+        // Bypassed same-process messages don't need to wait
+        if (!bypass_pop(wrapper, msg_data)) {
+            Duration_t timeout(timeout_ms / 1000, static_cast<uint32_t>((timeout_ms % 1000) * 1000000));
+            if (!wrapper->reader->wait_for_unread_message(timeout)) {
+                return CARDINAL_RECV_TIMEOUT;
+            }
+
+            SampleInfo info;
+            ReturnCode_t ret = wrapper->reader->read_next_sample(&msg_data, &info);
+            if (ret != RETCODE_OK) {
+                wrapper->stats.record_take(ret);
+                return CARDINAL_RECV_ERROR;
+            }
+        }
+
+        strncpy(msg->message, msg_data.message.c_str(), 255);
+        msg->message[255] = '\0';
+        msg->timestamp = msg_data.timestamp;
+        msg->key = msg_data.key;
+        wrapper->stats.record_receive(msg_data.message.length());
+        return CARDINAL_RECV_OK;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_simple_message_timed: " << e.what() << std::endl;
+        return CARDINAL_RECV_ERROR;
+    }
+}
+
+int receive_simple_messages(SimpleDDSSubscriber sub, SimpleMessage* out, size_t max, size_t* got) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !out || !got) {
+        return -1;
+    }
+
+    *got = 0;
+    if (max == 0) {
+        return 0;
+    }
+
+    try {
+        // Drain bypassed same-process messages first
+        size_t count = 0;
+        SimpleMessageData bypassed;
+        while (count < max && bypass_pop(wrapper, bypassed)) {
+            strncpy(out[count].message, bypassed.message.c_str(), 255);
+            out[count].message[255] = '\0';
+            out[count].timestamp = bypassed.timestamp;
+            out[count].key = bypassed.key;
+            wrapper->stats.record_receive(bypassed.message.length());
+            count++;
+        }
+        if (count == max) {
+            *got = count;
+            return 0;
+        }
+
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_TAKE);
+        LoanableSequence<SimpleMessageData> samples;
+        SampleInfoSeq infos;
+
+        ReturnCode_t ret = wrapper->reader->take(samples, infos, static_cast<int32_t>(max - count));
+        if (ret != RETCODE_OK) {
+            *got = count;
+            if (ret == RETCODE_NO_DATA) {
+                return 0; // No more data available
+            }
+            wrapper->stats.record_take(ret);
+            return -1;
+        }
+        for (int32_t i = 0; i < samples.length(); ++i) {
+            if (!infos[i].valid_data) {
+                continue;
+            }
+            strncpy(out[count].message, samples[i].message.c_str(), 255);
+            out[count].message[255] = '\0';
+            out[count].timestamp = samples[i].timestamp;
+            out[count].key = samples[i].key;
+            wrapper->stats.record_receive(samples[i].message.length());
+            count++;
+        }
+
+        wrapper->reader->return_loan(samples, infos);
+        *got = count;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_simple_messages: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int read_latest_for_key(SimpleDDSSubscriber sub, unsigned int key, SimpleMessage* msg) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !msg) {
+        return -1;
+    }
+
+    try {
+        // Resolve the key to its instance handle, then read only that
+        // instance's cached samples -- no scan over the rest of the stream
+        SimpleMessageData key_holder;
+        key_holder.key = key;
+        InstanceHandle_t handle = wrapper->reader->lookup_instance(&key_holder);
+        if (!handle.isDefined()) {
+            return -1; // Key never seen
+        }
+
+        LoanableSequence<SimpleMessageData> samples;
+        SampleInfoSeq infos;
+        ReturnCode_t ret = wrapper->reader->read_instance(samples, infos, LENGTH_UNLIMITED, handle);
+        if (ret != RETCODE_OK) {
+            wrapper->stats.record_take(ret);
+            return -1;
+        }
+
+        // Newest sample is last in the instance's history
+        int result = -1;
+        for (int32_t i = samples.length() - 1; i >= 0; --i) {
+            if (!infos[i].valid_data) {
+                continue;
+            }
+            strncpy(msg->message, samples[i].message.c_str(), 255);
+            msg->message[255] = '\0';
+            msg->timestamp = samples[i].timestamp;
+            msg->key = samples[i].key;
+            result = 0;
+            break;
+        }
+
+        wrapper->reader->return_loan(samples, infos);
+        return result;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in read_latest_for_key: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int receive_loan(SimpleDDSSubscriber sub, SimpleMessageLoan* loan) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !loan || wrapper->loan_active) {
+        return -1;
+    }
+
+    try {
+        // Bypassed same-process messages first, like the copying receive
+        // calls; the loan then points at the wrapper-held message (its string
+        // capacity is reused across loans) instead of the reader cache
+        if (bypass_pop(wrapper, wrapper->loan_bypass)) {
+            loan->message = wrapper->loan_bypass.message.c_str();
+            loan->length = wrapper->loan_bypass.message.length();
+            loan->timestamp = wrapper->loan_bypass.timestamp;
+            loan->key = wrapper->loan_bypass.key;
+            loan->handle = wrapper;
+            wrapper->loan_active = true;
+            wrapper->loan_from_bypass = true;
+            wrapper->stats.record_receive(wrapper->loan_bypass.message.length());
+            return 0;
+        }
+
+        ReturnCode_t take_ret = wrapper->reader->take(wrapper->loan_samples, wrapper->loan_infos, 1);
+        if (take_ret != RETCODE_OK) {
+            wrapper->stats.record_take(take_ret);
+            return -1; // No data available
+        }
+
+        if (wrapper->loan_samples.length() < 1 || !wrapper->loan_infos[0].valid_data) {
+            wrapper->reader->return_loan(wrapper->loan_samples, wrapper->loan_infos);
+            return -1;
+        }
+
+        // Expose the sample straight out of the reader cache -- no copy
+        const SimpleMessageData& msg_data = wrapper->loan_samples[0];
+        loan->message = msg_data.message.c_str();
+        loan->length = msg_data.message.length();
+        loan->timestamp = msg_data.timestamp;
+        loan->key = msg_data.key;
+        loan->handle = wrapper;
+        wrapper->loan_active = true;
+        wrapper->stats.record_receive(msg_data.message.length());
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_loan: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int return_loan(SimpleDDSSubscriber sub, SimpleMessageLoan* loan) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !loan || !wrapper->loan_active) {
+        return -1;
+    }
+
+    try {
+        ReturnCode_t ret = RETCODE_OK;
+        if (wrapper->loan_from_bypass) {
+            // Nothing to hand back to the reader, the message was ours
+            wrapper->loan_from_bypass = false;
+        } else {
+            ret = wrapper->reader->return_loan(wrapper->loan_samples, wrapper->loan_infos);
+        }
+        wrapper->loan_active = false;
+        loan->message = nullptr;
+        loan->length = 0;
+        loan->handle = nullptr;
+        return ret == RETCODE_OK ? 0 : -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in return_loan: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int get_liveliness_changed(SimpleDDSSubscriber sub, CardinalLivelinessStats* stats) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->listener || !stats) {
+        return -1;
+    }
+
+    stats->alive_count = static_cast<unsigned int>(
+        wrapper->listener->alive_count.load(std::memory_order_relaxed));
+    stats->not_alive_count = static_cast<unsigned int>(
+        wrapper->listener->not_alive_count.load(std::memory_order_relaxed));
+    stats->change_events = wrapper->listener->change_events.load(std::memory_order_relaxed);
+    return 0;
+}
+
+unsigned long long get_missed_deadlines(SimpleDDSSubscriber sub) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->listener) {
+        return 0;
+    }
+    return wrapper->listener->missed_deadlines.load(std::memory_order_relaxed);
+}
+
+void destroy_simple_subscriber(SimpleDDSSubscriber sub) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (wrapper) {
+        unregister_local_subscriber(wrapper);
+        if (wrapper->reader) wrapper->subscriber->delete_datareader(wrapper->reader);
+        if (wrapper->subscriber) cardinal_release_subscriber(wrapper->domain_id, wrapper->subscriber);
+        if (wrapper->filtered_topic) wrapper->participant->delete_contentfilteredtopic(wrapper->filtered_topic);
+        if (wrapper->topic) cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+        if (wrapper->participant) cardinal_release_participant(wrapper->domain_id);
+        delete wrapper;
+    }
+}
+
+CardinalMux mux_create(void) {
+    try {
+        return new CardinalMuxWrapper();
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in mux_create: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+int mux_add(CardinalMux mux, SimpleDDSSubscriber sub, int tag) {
+    CardinalMuxWrapper* wrapper = static_cast<CardinalMuxWrapper*>(mux);
+    SimpleSubscriberWrapper* sub_wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !sub_wrapper || !sub_wrapper->reader) {
+        return -1;
+    }
+
+    try {
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+
+        StatusCondition& condition = sub_wrapper->reader->get_statuscondition();
+        if (condition.set_enabled_statuses(StatusMask::data_available()) != RETCODE_OK ||
+            wrapper->waitset.attach_condition(condition) != RETCODE_OK) {
+            return -1;
+        }
+
+        MuxEntry entry;
+        entry.condition = &condition;
+        entry.tag = tag;
+        wrapper->entries.push_back(entry);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in mux_add: " << e.what() << std::endl;
+        return -1;
     }
+}
 
-    bool deserialize(SerializedPayload_t& payload, void* data) override {
-        SimpleMessageData* msg_data = static_cast<SimpleMessageData*>(data);
-        
-        payload.pos = 0;
-        
-        // Deserialize message length
-        uint32_t msg_len;
-        memcpy(&msg_len, payload.data + payload.pos, sizeof(uint32_t));
-        payload.pos += sizeof(uint32_t);
-        
-        // Deserialize message
-        char buffer[256];
-        memcpy(buffer, payload.data + payload.pos, std::min(msg_len, 255u));
-        buffer[std::min(msg_len, 255u)] = '\0';
-        msg_data->message = std::string(buffer);
-        payload.pos += msg_len;
-        
-        // Deserialize timestamp
-        memcpy(&msg_data->timestamp, payload.data + payload.pos, sizeof(int64_t));
-        payload.pos += sizeof(int64_t);
-        
-        return true;
+int mux_wait(CardinalMux mux, int timeout_ms, int* tags_out, size_t max_events, size_t* got) {
+    CardinalMuxWrapper* wrapper = static_cast<CardinalMuxWrapper*>(mux);
+    if (!wrapper || !tags_out || !got) {
+        return -1;
     }
 
-    uint32_t calculate_serialized_size(const void* data, DataRepresentationId_t representation) override {
-        const SimpleMessageData* msg_data = static_cast<const SimpleMessageData*>(data);
-        return sizeof(uint32_t) + msg_data->message.length() + sizeof(int64_t);
-    }
+    *got = 0;
 
-    void* create_data() override {
-        return new SimpleMessageData();
+    try {
+        Duration_t timeout(timeout_ms / 1000, static_cast<uint32_t>((timeout_ms % 1000) * 1000000));
+        ConditionSeq active;
+
+        ReturnCode_t ret = wrapper->waitset.wait(active, timeout);
+        if (ret == RETCODE_TIMEOUT) {
+            return 0;
+        }
+        if (ret != RETCODE_OK) {
+            return -1;
+        }
+
+        std::lock_guard<std::mutex> lock(wrapper->mutex);
+        size_t count = 0;
+        for (Condition* condition : active) {
+            if (count >= max_events) {
+                break;
+            }
+            for (const MuxEntry& entry : wrapper->entries) {
+                if (entry.condition == condition) {
+                    tags_out[count++] = entry.tag;
+                    break;
+                }
+            }
+        }
+
+        *got = count;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in mux_wait: " << e.what() << std::endl;
+        return -1;
     }
+}
 
-    void delete_data(void* data) override {
-        delete static_cast<SimpleMessageData*>(data);
+void mux_destroy(CardinalMux mux) {
+    CardinalMuxWrapper* wrapper = static_cast<CardinalMuxWrapper*>(mux);
+    if (wrapper) {
+        for (const MuxEntry& entry : wrapper->entries) {
+            wrapper->waitset.detach_condition(*entry.condition);
+        }
+        delete wrapper;
     }
+}
 
-    bool compute_key(SerializedPayload_t& payload, InstanceHandle_t& handle, bool force_md5) override {
-        return true;
+void destroy_bridge(CardinalBridge bridge) {
+    CardinalBridgeWrapper* wrapper = static_cast<CardinalBridgeWrapper*>(bridge);
+    if (wrapper) {
+        // Detach the forwarder before tearing down the writer it feeds
+        if (wrapper->reader) wrapper->reader->set_listener(nullptr, StatusMask::none());
+        if (wrapper->reader) wrapper->subscriber->delete_datareader(wrapper->reader);
+        if (wrapper->writer) wrapper->publisher->delete_datawriter(wrapper->writer);
+        if (wrapper->subscriber) wrapper->src_participant->delete_subscriber(wrapper->subscriber);
+        if (wrapper->publisher) wrapper->dst_participant->delete_publisher(wrapper->publisher);
+        if (wrapper->src_topic) wrapper->src_participant->delete_topic(wrapper->src_topic);
+        if (wrapper->dst_topic) wrapper->dst_participant->delete_topic(wrapper->dst_topic);
+        if (wrapper->src_participant) {
+            DomainParticipantFactory::get_instance()->delete_participant(wrapper->src_participant);
+        }
+        if (wrapper->dst_participant) {
+            DomainParticipantFactory::get_instance()->delete_participant(wrapper->dst_participant);
+        }
+        delete wrapper;
     }
+}
 
-    bool compute_key(const void* data, InstanceHandle_t& handle, bool force_md5) override {
-        return true;
+CardinalBridge create_bridge(unsigned int src_domain, unsigned int dst_domain, const char* topic_name) {
+    if (!topic_name) {
+        return nullptr;
     }
-};
 
-// Publisher wrapper
-struct SimplePublisherWrapper {
-    DomainParticipant* participant;
-    Publisher* publisher;
-    Topic* topic;
-    DataWriter* writer;
-    TypeSupport type_support;
-};
+    try {
+        CardinalBridgeWrapper* wrapper = new CardinalBridgeWrapper();
 
-// Subscriber wrapper
-struct SimpleSubscriberWrapper {
-    DomainParticipant* participant;
-    Subscriber* subscriber;
-    Topic* topic;
-    DataReader* reader;
-    TypeSupport type_support;
-};
+        // The bridge runs on its own participants: the pooled ones already
+        // register the real "SimpleMessage" type, and a participant cannot
+        // carry two types under one name
+        wrapper->src_participant = DomainParticipantFactory::get_instance()->create_participant(
+            src_domain, PARTICIPANT_QOS_DEFAULT);
+        wrapper->dst_participant = DomainParticipantFactory::get_instance()->create_participant(
+            dst_domain, PARTICIPANT_QOS_DEFAULT);
+        if (!wrapper->src_participant || !wrapper->dst_participant) {
+            std::cerr << "Failed to create bridge participants" << std::endl;
+            destroy_bridge(wrapper);
+            return nullptr;
+        }
 
-extern "C" {
+        // Pass-through type masquerading as SimpleMessage, so the bridge
+        // matches the real endpoints on both domains
+        wrapper->src_type = TypeSupport(new RawPassthroughTypeSupport("SimpleMessage"));
+        wrapper->dst_type = TypeSupport(new RawPassthroughTypeSupport("SimpleMessage"));
+        if (wrapper->src_type.register_type(wrapper->src_participant) != RETCODE_OK ||
+            wrapper->dst_type.register_type(wrapper->dst_participant) != RETCODE_OK) {
+            std::cerr << "Failed to register bridge type" << std::endl;
+            destroy_bridge(wrapper);
+            return nullptr;
+        }
 
-SimpleDDSPublisher create_simple_publisher(const char* topic_name) {
-    try {
-        // Create participant
-        DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(
-            0, PARTICIPANT_QOS_DEFAULT);
-        if (!participant) {
-            std::cerr << "Failed to create participant" << std::endl;
+        wrapper->src_topic = wrapper->src_participant->create_topic(
+            topic_name, wrapper->src_type.get_type_name(), TOPIC_QOS_DEFAULT);
+        wrapper->dst_topic = wrapper->dst_participant->create_topic(
+            topic_name, wrapper->dst_type.get_type_name(), TOPIC_QOS_DEFAULT);
+        if (!wrapper->src_topic || !wrapper->dst_topic) {
+            std::cerr << "Failed to create bridge topics" << std::endl;
+            destroy_bridge(wrapper);
             return nullptr;
         }
 
-        // Create wrapper
+        wrapper->subscriber = wrapper->src_participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        wrapper->publisher = wrapper->dst_participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+        if (!wrapper->subscriber || !wrapper->publisher) {
+            std::cerr << "Failed to create bridge factories" << std::endl;
+            destroy_bridge(wrapper);
+            return nullptr;
+        }
+
+        wrapper->writer = wrapper->publisher->create_datawriter(wrapper->dst_topic, DATAWRITER_QOS_DEFAULT);
+        if (!wrapper->writer) {
+            std::cerr << "Failed to create bridge writer" << std::endl;
+            destroy_bridge(wrapper);
+            return nullptr;
+        }
+
+        // The forwarder starts moving samples the moment the reader exists
+        wrapper->forwarder.reset(new BridgeForwarder());
+        wrapper->forwarder->writer = wrapper->writer;
+        wrapper->forwarder->stats = &wrapper->stats;
+        wrapper->reader = wrapper->subscriber->create_datareader(
+            wrapper->src_topic, DATAREADER_QOS_DEFAULT, wrapper->forwarder.get(),
+            StatusMask::data_available() | StatusMask::sample_lost());
+        if (!wrapper->reader) {
+            std::cerr << "Failed to create bridge reader" << std::endl;
+            destroy_bridge(wrapper);
+            return nullptr;
+        }
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_bridge: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+CardinalSamplePublisher create_sample_publisher(const char* topic_name) {
+    try {
         SimplePublisherWrapper* wrapper = new SimplePublisherWrapper();
-        wrapper->participant = participant;
-        wrapper->type_support = TypeSupport(new SimpleMessageTypeSupport());
+        wrapper->domain_id = 0;
 
-        // Register type
-        if (wrapper->type_support.register_type(participant) != RETCODE_OK) {
-            std::cerr << "Failed to register type" << std::endl;
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, nullptr);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
             delete wrapper;
             return nullptr;
         }
+        wrapper->participant = entry->participant;
+        wrapper->type_support = entry->sample_type_support;
 
-        // Create topic
-        wrapper->topic = participant->create_topic(
-            topic_name, wrapper->type_support.get_type_name(), TOPIC_QOS_DEFAULT);
+        wrapper->topic = cardinal_get_topic(entry, topic_name, entry->sample_type_support.get_type_name());
         if (!wrapper->topic) {
             std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
-        // Create publisher
-        wrapper->publisher = participant->create_publisher(PUBLISHER_QOS_DEFAULT);
+        wrapper->publisher = cardinal_get_publisher(entry, nullptr);
         if (!wrapper->publisher) {
             std::cerr << "Failed to create publisher" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
-        // Create writer
         wrapper->writer = wrapper->publisher->create_datawriter(wrapper->topic, DATAWRITER_QOS_DEFAULT);
         if (!wrapper->writer) {
             std::cerr << "Failed to create writer" << std::endl;
+            cardinal_release_publisher(wrapper->domain_id, wrapper->publisher);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
         return wrapper;
     } catch (const std::exception& e) {
-        std::cerr << "Exception in create_simple_publisher: " << e.what() << std::endl;
+        std::cerr << "Exception in create_sample_publisher: " << e.what() << std::endl;
         return nullptr;
     }
 }
 
-int publish_simple_message(SimpleDDSPublisher pub, const char* message, long timestamp) {
+int publish_sample(CardinalSamplePublisher pub, const CardinalSample* sample) {
     SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
-    if (!wrapper || !wrapper->writer) {
+    if (!wrapper || !wrapper->writer || !sample) {
         return -1;
     }
 
     try {
-        SimpleMessageData msg_data(std::string(message), timestamp);
-        return wrapper->writer->write(&msg_data) == RETCODE_OK ? 0 : -1;
+        return timed_write(wrapper->writer, sample, sizeof(CardinalSample), wrapper->stats) == RETCODE_OK ? 0 : -1;
     } catch (const std::exception& e) {
-        std::cerr << "Exception in publish_simple_message: " << e.what() << std::endl;
+        std::cerr << "Exception in publish_sample: " << e.what() << std::endl;
         return -1;
     }
 }
 
-void destroy_simple_publisher(SimpleDDSPublisher pub) {
+int publish_samples_batch(CardinalSamplePublisher pub, const CardinalSample* samples, size_t count) {
     SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
-    if (wrapper) {
-        if (wrapper->writer) wrapper->publisher->delete_datawriter(wrapper->writer);
-        if (wrapper->topic) wrapper->participant->delete_topic(wrapper->topic);
-        if (wrapper->publisher) wrapper->participant->delete_publisher(wrapper->publisher);
-        if (wrapper->participant) DomainParticipantFactory::get_instance()->delete_participant(wrapper->participant);
-        delete wrapper;
+    if (!wrapper || !wrapper->writer || !samples) {
+        return -1;
+    }
+
+    try {
+        size_t written = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (timed_write(wrapper->writer, &samples[i], sizeof(CardinalSample), wrapper->stats) != RETCODE_OK) {
+                break;
+            }
+            written++;
+        }
+        return static_cast<int>(written);
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publish_samples_batch: " << e.what() << std::endl;
+        return -1;
     }
 }
 
-SimpleDDSSubscriber create_simple_subscriber(const char* topic_name) {
+void destroy_sample_publisher(CardinalSamplePublisher pub) {
+    destroy_simple_publisher(pub);
+}
+
+CardinalSampleSubscriber create_sample_subscriber(const char* topic_name) {
     try {
-        // Create participant
-        DomainParticipant* participant = DomainParticipantFactory::get_instance()->create_participant(
-            0, PARTICIPANT_QOS_DEFAULT);
-        if (!participant) {
+        SimpleSubscriberWrapper* wrapper = new SimpleSubscriberWrapper();
+        wrapper->domain_id = 0;
+
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, nullptr);
+        if (!entry) {
             std::cerr << "Failed to create participant" << std::endl;
+            delete wrapper;
             return nullptr;
         }
+        wrapper->participant = entry->participant;
+        wrapper->type_support = entry->sample_type_support;
 
-        // Create wrapper
+        wrapper->topic = cardinal_get_topic(entry, topic_name, entry->sample_type_support.get_type_name());
+        if (!wrapper->topic) {
+            std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->subscriber = cardinal_get_subscriber(entry, nullptr);
+        if (!wrapper->subscriber) {
+            std::cerr << "Failed to create subscriber" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->reader = wrapper->subscriber->create_datareader(wrapper->topic, DATAREADER_QOS_DEFAULT);
+        if (!wrapper->reader) {
+            std::cerr << "Failed to create reader" << std::endl;
+            cardinal_release_subscriber(wrapper->domain_id, wrapper->subscriber);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_sample_subscriber: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+int receive_sample(CardinalSampleSubscriber sub, CardinalSample* sample) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !sample) {
+        return -1;
+    }
+
+    try {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_TAKE);
+        SampleInfo info;
+        ReturnCode_t ret = wrapper->reader->take_next_sample(sample, &info);
+        if (ret != RETCODE_OK || !info.valid_data) {
+            wrapper->stats.record_take(ret);
+            return -1; // No data available
+        }
+        wrapper->stats.record_receive(sizeof(CardinalSample));
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_sample: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int receive_samples(CardinalSampleSubscriber sub, CardinalSample* out, size_t max, size_t* got) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader || !out || !got) {
+        return -1;
+    }
+
+    *got = 0;
+    if (max == 0) {
+        return 0;
+    }
+
+    try {
+        CARDINAL_TRACE_SPAN(CARDINAL_TRACE_TAKE);
+        LoanableSequence<CardinalSample> samples;
+        SampleInfoSeq infos;
+
+        ReturnCode_t ret = wrapper->reader->take(samples, infos, static_cast<int32_t>(max));
+        if (ret != RETCODE_OK) {
+            if (ret == RETCODE_NO_DATA) {
+                return 0; // No data available
+            }
+            wrapper->stats.record_take(ret);
+            return -1;
+        }
+
+        size_t count = 0;
+        for (int32_t i = 0; i < samples.length(); ++i) {
+            if (!infos[i].valid_data) {
+                continue;
+            }
+            out[count++] = samples[i];
+            wrapper->stats.record_receive(sizeof(CardinalSample));
+        }
+
+        wrapper->reader->return_loan(samples, infos);
+        *got = count;
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in receive_samples: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int enable_aggregation(CardinalSampleSubscriber sub, unsigned int window_ms) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->reader) {
+        return -1;
+    }
+
+    try {
+        // Install the new aggregator before releasing the old one: resetting
+        // first would free a listener the reader is still pointing at
+        std::unique_ptr<SampleAggregator> aggregator(new SampleAggregator(&wrapper->stats, window_ms));
+        if (wrapper->reader->set_listener(aggregator.get(),
+                                          StatusMask::data_available() | StatusMask::sample_lost()) != RETCODE_OK) {
+            return -1;
+        }
+        wrapper->aggregator = std::move(aggregator);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in enable_aggregation: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+int read_window_stats(CardinalSampleSubscriber sub, CardinalWindowStats* stats) {
+    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
+    if (!wrapper || !wrapper->aggregator || !stats) {
+        return -1;
+    }
+
+    try {
+        wrapper->aggregator->read(stats);
+        return 0;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in read_window_stats: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+void destroy_sample_subscriber(CardinalSampleSubscriber sub) {
+    destroy_simple_subscriber(sub);
+}
+
+CardinalBlobPublisher create_blob_publisher(const char* topic_name) {
+    try {
+        SimplePublisherWrapper* wrapper = new SimplePublisherWrapper();
+        wrapper->domain_id = 0;
+
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, nullptr);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
+            delete wrapper;
+            return nullptr;
+        }
+        wrapper->participant = entry->participant;
+        wrapper->type_support = entry->blob_type_support;
+
+        wrapper->topic = cardinal_get_topic(entry, topic_name, entry->blob_type_support.get_type_name());
+        if (!wrapper->topic) {
+            std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->publisher = cardinal_get_publisher(entry, nullptr);
+        if (!wrapper->publisher) {
+            std::cerr << "Failed to create publisher" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        wrapper->writer = wrapper->publisher->create_datawriter(wrapper->topic, DATAWRITER_QOS_DEFAULT);
+        if (!wrapper->writer) {
+            std::cerr << "Failed to create writer" << std::endl;
+            cardinal_release_publisher(wrapper->domain_id, wrapper->publisher);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
+            delete wrapper;
+            return nullptr;
+        }
+
+        return wrapper;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in create_blob_publisher: " << e.what() << std::endl;
+        return nullptr;
+    }
+}
+
+int publish_blob(CardinalBlobPublisher pub, const unsigned char* data, size_t size, long timestamp) {
+    SimplePublisherWrapper* wrapper = static_cast<SimplePublisherWrapper*>(pub);
+    if (!wrapper || !wrapper->writer || (!data && size > 0)) {
+        return -1;
+    }
+
+    try {
+        CardinalBlobData blob;
+        blob.payload.assign(data, data + size);
+        blob.timestamp = timestamp;
+        return timed_write(wrapper->writer, &blob, blob.payload.size(), wrapper->stats) == RETCODE_OK ? 0 : -1;
+    } catch (const std::exception& e) {
+        std::cerr << "Exception in publish_blob: " << e.what() << std::endl;
+        return -1;
+    }
+}
+
+void destroy_blob_publisher(CardinalBlobPublisher pub) {
+    destroy_simple_publisher(pub);
+}
+
+CardinalBlobSubscriber create_blob_subscriber(const char* topic_name) {
+    try {
         SimpleSubscriberWrapper* wrapper = new SimpleSubscriberWrapper();
-        wrapper->participant = participant;
-        wrapper->type_support = TypeSupport(new SimpleMessageTypeSupport());
+        wrapper->domain_id = 0;
 
-        // Register type
-        if (wrapper->type_support.register_type(participant) != RETCODE_OK) {
-            std::cerr << "Failed to register type" << std::endl;
+        ParticipantEntry* entry = cardinal_get_participant(wrapper->domain_id, nullptr);
+        if (!entry) {
+            std::cerr << "Failed to create participant" << std::endl;
             delete wrapper;
             return nullptr;
         }
+        wrapper->participant = entry->participant;
+        wrapper->type_support = entry->blob_type_support;
 
-        // Create topic
-        wrapper->topic = participant->create_topic(
-            topic_name, wrapper->type_support.get_type_name(), TOPIC_QOS_DEFAULT);
+        wrapper->topic = cardinal_get_topic(entry, topic_name, entry->blob_type_support.get_type_name());
         if (!wrapper->topic) {
             std::cerr << "Failed to create topic" << std::endl;
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
-        // Create subscriber
-        wrapper->subscriber = participant->create_subscriber(SUBSCRIBER_QOS_DEFAULT);
+        wrapper->subscriber = cardinal_get_subscriber(entry, nullptr);
         if (!wrapper->subscriber) {
             std::cerr << "Failed to create subscriber" << std::endl;
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
-        // Create reader
         wrapper->reader = wrapper->subscriber->create_datareader(wrapper->topic, DATAREADER_QOS_DEFAULT);
         if (!wrapper->reader) {
             std::cerr << "Failed to create reader" << std::endl;
+            cardinal_release_subscriber(wrapper->domain_id, wrapper->subscriber);
+            cardinal_release_topic(wrapper->domain_id, wrapper->topic);
+            cardinal_release_participant(wrapper->domain_id);
             delete wrapper;
             return nullptr;
         }
 
         return wrapper;
     } catch (const std::exception& e) {
-        std::cerr << "Exception in create_simple_subscriber: " << e.what() << std::endl;
+        std::cerr << "Exception in create_blob_subscriber: " << e.what() << std::endl;
         return nullptr;
     }
 }
 
-int receive_simple_message(SimpleDDSSubscriber sub, SimpleMessage* msg) {
+int receive_blob(CardinalBlobSubscriber sub, unsigned char* buffer, size_t capacity, size_t* size, long* timestamp) {
     SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
-    if (!wrapper || !wrapper->reader) {
+    if (!wrapper || !wrapper->reader || !buffer || !size) {
         return -1;
     }
 
     try {
         SampleInfo info;
-        SimpleMessageData msg_data;
-        
-        if (wrapper->reader->read_next_sample(&msg_data, &info) == RETCODE_OK) {
-            strncpy(msg->message, msg_data.message.c_str(), 255);
-            msg->message[255] = '\0';
-            msg->timestamp = msg_data.timestamp;
-            return 0;
+        CardinalBlobData blob;
+
+        ReturnCode_t ret = wrapper->reader->take_next_sample(&blob, &info);
+        if (ret != RETCODE_OK || !info.valid_data) {
+            wrapper->stats.record_take(ret);
+            return -1; // No data available
         }
-        return -1; // No data available
+
+        if (blob.payload.size() > capacity) {
+            std::cerr << "Blob of " << blob.payload.size() << " bytes exceeds caller buffer" << std::endl;
+            return -1;
+        }
+
+        memcpy(buffer, blob.payload.data(), blob.payload.size());
+        *size = blob.payload.size();
+        wrapper->stats.record_receive(blob.payload.size());
+        if (timestamp) {
+            *timestamp = static_cast<long>(blob.timestamp);
+        }
+        return 0;
     } catch (const std::exception& e) {
-        std::cerr << "Exception in receive_simple_message: " << e.what() << std::endl;
+        std::cerr << "Exception in receive_blob: " << e.what() << std::endl;
         return -1;
     }
 }
 
-void destroy_simple_subscriber(SimpleDDSSubscriber sub) {
-    SimpleSubscriberWrapper* wrapper = static_cast<SimpleSubscriberWrapper*>(sub);
-    if (wrapper) {
-        if (wrapper->reader) wrapper->subscriber->delete_datareader(wrapper->reader);
-        if (wrapper->topic) wrapper->participant->delete_topic(wrapper->topic);
-        if (wrapper->subscriber) wrapper->participant->delete_subscriber(wrapper->subscriber);
-        if (wrapper->participant) DomainParticipantFactory::get_instance()->delete_participant(wrapper->participant);
-        delete wrapper;
-    }
+void destroy_blob_subscriber(CardinalBlobSubscriber sub) {
+    destroy_simple_subscriber(sub);
 }
 
 }
\ No newline at end of file
@@ -1,30 +1,364 @@
 #ifndef FASTDDS_SIMPLE_H
 #define FASTDDS_SIMPLE_H
 
+#include <stddef.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
 
-// Simple message structure
+// Simple message structure. key identifies the instance (e.g. a sensor id)
+// on keyed topics; unkeyed publishers leave it at 0.
 typedef struct {
     char message[256];
     long timestamp;
+    unsigned int key;
 } SimpleMessage;
 
+// View of a sample loaned from the reader cache (zero-copy receive).
+// The pointer stays valid until return_loan() is called.
+typedef struct {
+    const char* message;   // points directly into the reader cache, not null-copied
+    size_t length;
+    long timestamp;
+    unsigned int key;
+    void* handle;          // internal loan bookkeeping, do not touch
+} SimpleMessageLoan;
+
 // Opaque handles for C interface
 typedef void* SimpleDDSPublisher;
 typedef void* SimpleDDSSubscriber;
 
+// Per-endpoint QoS knobs. Start from cardinal_default_qos() and override what
+// you need; a 0/_DEFAULT value always means "keep the FastDDS default".
+typedef enum {
+    CARDINAL_RELIABILITY_DEFAULT = 0,
+    CARDINAL_RELIABILITY_BEST_EFFORT = 1,
+    CARDINAL_RELIABILITY_RELIABLE = 2
+} CardinalReliability;
+
+typedef enum {
+    CARDINAL_HISTORY_DEFAULT = 0,
+    CARDINAL_HISTORY_KEEP_LAST = 1,
+    CARDINAL_HISTORY_KEEP_ALL = 2
+} CardinalHistoryKind;
+
+typedef enum {
+    CARDINAL_DURABILITY_DEFAULT = 0,
+    CARDINAL_DURABILITY_VOLATILE = 1,
+    CARDINAL_DURABILITY_TRANSIENT_LOCAL = 2
+} CardinalDurability;
+
+typedef enum {
+    CARDINAL_WIRE_FORMAT_V1 = 0,          // fixed-width CDR framing (default)
+    CARDINAL_WIRE_FORMAT_V2 = 2           // varint framing, optional compression
+} CardinalWireFormat;
+
+typedef enum {
+    CARDINAL_TRANSPORT_DEFAULT = 0,       // FastDDS builtin transports
+    CARDINAL_TRANSPORT_UDP = 1,           // UDPv4 only
+    CARDINAL_TRANSPORT_SHM = 2            // shared memory only, plus data-sharing
+                                          // on the endpoints (same-host delivery)
+} CardinalTransport;
+
+typedef struct {
+    int reliability;                      // CardinalReliability
+    int history_kind;                     // CardinalHistoryKind
+    int history_depth;                    // samples kept per instance with KEEP_LAST
+    int durability;                       // CardinalDurability
+    int transport;                        // CardinalTransport; participant-level,
+                                          // first creator in a domain wins
+    // Comma-separated initial peers ("host" or "host:port") for unicast
+    // discovery, e.g. "10.0.0.5,10.0.0.6:7412". On locked-down subnets where
+    // multicast SPDP takes seconds, seeding peers lets endpoints match in
+    // tens of milliseconds. Participant-level: first creator in a domain
+    // wins. NULL keeps multicast-only discovery.
+    const char* initial_peers;
+    // DDS partition name (NULL or "" = default partition). Endpoints only
+    // match peers in the same partition, so sharded consumer groups stop
+    // paying O(writers x readers) discovery cost across the whole fleet.
+    // Only read during create; the string need not outlive the call.
+    const char* partition;
+    // Writer pacing: when max_bytes_per_period > 0 the writer publishes
+    // asynchronously through a flow controller limited to that many bytes per
+    // flow_period_ms (default 100 ms), so bursts are smoothed instead of
+    // flooding slow links. The controller is registered when the domain's
+    // shared participant is first created, so the first creator must request
+    // it for later writers to use it.
+    unsigned long long max_bytes_per_period;
+    unsigned int flow_period_ms;
+    // UDP socket buffer sizes in bytes (0 = transport default). Applied when
+    // the shared participant for the domain is first created; later creators
+    // inherit whatever the first one configured.
+    unsigned int send_socket_buffer_size;
+    unsigned int recv_socket_buffer_size;
+    // Deadline/liveliness monitoring (0 = leave both QoS at their defaults).
+    // deadline_ms makes the writer offer -- and the reader require -- a new
+    // sample per instance every deadline_ms; misses are counted on the
+    // subscriber (get_missed_deadlines()). liveliness_lease_ms sets an
+    // AUTOMATIC liveliness lease: a publisher that goes silent for the lease
+    // is declared not-alive and the subscriber's liveliness counters update
+    // within the lease period instead of whenever a dashboard flatlines.
+    unsigned int deadline_ms;
+    unsigned int liveliness_lease_ms;
+    // Wire format for SimpleMessage endpoints (CardinalWireFormat). V2 frames
+    // with varints instead of fixed-width CDR fields (~40% less framing on
+    // short messages) and, when the library is built with `zig build
+    // -Dlz4=true`, LZ4-compresses payloads above 512 bytes. V2 endpoints register the
+    // "SimpleMessageV2" topic type, so both sides of a topic must opt in --
+    // mixed-format endpoints simply never match, and v1 stays the default.
+    int wire_format;
+} CardinalQos;
+
+// Fixed-layout numeric telemetry sample: exactly 24 bytes, no padding, so an
+// array of them is contiguous and SIMD-friendly and serialization is a single
+// memcpy -- unlike numbers formatted into SimpleMessage.message as text that
+// every consumer re-parses. key identifies the DDS instance (as in
+// SimpleMessage.key); flags is application-defined.
+typedef struct {
+    unsigned int key;
+    unsigned int flags;
+    double value;
+    long timestamp;
+} CardinalSample;
+
+// Opaque handles for numeric sample endpoints
+typedef void* CardinalSamplePublisher;
+typedef void* CardinalSampleSubscriber;
+
+// Opaque handles for binary (blob) endpoints
+typedef void* CardinalBlobPublisher;
+typedef void* CardinalBlobSubscriber;
+
+// Opaque handle for the multi-topic multiplexer
+typedef void* CardinalMux;
+
+// Opaque handle for the cross-domain bridge
+typedef void* CardinalBridge;
+
+// Per-endpoint performance counters, maintained with relaxed atomics so the
+// accounting stays off the hot path. write_latency_us is a power-of-two
+// histogram: bucket i counts writes that took [2^i, 2^(i+1)) microseconds,
+// with the last bucket catching everything slower.
+#define CARDINAL_LATENCY_BUCKETS 16
+
+typedef struct {
+    unsigned long long messages;      // published / received through the endpoint
+    unsigned long long bytes;         // payload bytes published / received
+    unsigned long long errors;        // failed writes or takes
+    unsigned long long samples_lost;  // middleware-reported losses (subscribers)
+    unsigned long long write_latency_us[CARDINAL_LATENCY_BUCKETS]; // publishers only
+    int last_error;                   // last FastDDS return code observed on error
+} CardinalStats;
+
+// Snapshot the counters for an endpoint. Returns 0 on success, -1 on error.
+int get_publisher_stats(SimpleDDSPublisher pub, CardinalStats* stats);
+int get_subscriber_stats(SimpleDDSSubscriber sub, CardinalStats* stats);
+
+// Hot-path tracepoints, for attributing publish/receive latency to the
+// serialize, write, take, and deserialize stages. Only compiled in when the
+// library is built with `zig build -Dtrace=true`; in a normal build the
+// probes vanish entirely and cardinal_set_trace_callback() returns -1.
+typedef enum {
+    CARDINAL_TRACE_SERIALIZE = 0,    // TopicDataType::serialize
+    CARDINAL_TRACE_WRITE = 1,        // DataWriter::write
+    CARDINAL_TRACE_TAKE = 2,         // DataReader take/read
+    CARDINAL_TRACE_DESERIALIZE = 3   // TopicDataType::deserialize
+} CardinalTracePoint;
+
+// cb fires on the thread that ran the traced stage, with its duration in
+// nanoseconds; keep it cheap. Pass a NULL cb to unregister.
+typedef void (*CardinalTraceCallback)(int point, unsigned long long duration_ns, void* ctx);
+int cardinal_set_trace_callback(CardinalTraceCallback cb, void* ctx);
+
+// Process-global intra-process bypass. When enabled, publishing on a topic
+// that also has subscribers in this process hands the message straight to
+// them -- through their callback if one is registered, otherwise through an
+// in-memory queue drained by the receive calls -- skipping serialization and
+// the RTPS stack entirely. Messages delivered this way do NOT reach other
+// processes, so only enable it for self-monitoring loops that are known to
+// be process-local. Disabled by default.
+void cardinal_set_intraprocess(int enable);
+
+// Returns a CardinalQos with every field set to its _DEFAULT/0 value
+CardinalQos cardinal_default_qos(void);
+
+// QoS-aware variants of the create calls; qos may be NULL for defaults
+SimpleDDSPublisher create_simple_publisher_with_qos(const char* topic_name, const CardinalQos* qos);
+SimpleDDSSubscriber create_simple_subscriber_with_qos(const char* topic_name, const CardinalQos* qos);
+
 // Publisher functions
 SimpleDDSPublisher create_simple_publisher(const char* topic_name);
+// Async variant: publish_simple_message() becomes a lock-free ring-buffer push
+// and a dedicated thread drains the ring into the DataWriter, so the caller
+// never blocks on reliable-QoS acknowledgements. Single producer only.
+// publish returns -1 when the ring is full (caller should back off).
+SimpleDDSPublisher create_simple_publisher_async(const char* topic_name);
+// Thread-safe variant: any number of threads may call the publish functions
+// on the handle concurrently, with no external mutex. Producers push into a
+// lock-free MPSC ring (wait-free enqueues in the common case) and a single
+// consumer thread drains into the DataWriter; messages from one producer are
+// written in the order that producer published them. publish returns -1 when
+// the ring is full (callers should back off).
+SimpleDDSPublisher create_simple_publisher_mpsc(const char* topic_name);
+// Messages queued but not yet handed to the DataWriter (0 for sync publishers)
+size_t publisher_pending_count(SimpleDDSPublisher pub);
 int publish_simple_message(SimpleDDSPublisher pub, const char* message, long timestamp);
+// Keyed publish: each key is a separate DDS instance, so KEEP_LAST history
+// (CardinalQos.history_depth) is kept per key rather than per topic.
+int publish_simple_message_keyed(SimpleDDSPublisher pub, unsigned int key, const char* message, long timestamp);
+// Publishes count messages in one call so a single FFI crossing covers the
+// whole batch. Returns the number of messages written, or -1 on error.
+int publish_simple_messages_batch(SimpleDDSPublisher pub, const SimpleMessage* msgs, size_t count);
 void destroy_simple_publisher(SimpleDDSPublisher pub);
 
+// Delivery callback shared by push subscriptions (set_message_callback) and
+// journal replay. The SimpleMessage pointer is only valid for the call.
+typedef void (*SimpleMessageCallback)(const SimpleMessage* msg, void* ctx);
+
+// Crash-safe journal: attaches a memory-mapped ring file of size_bytes to a
+// publisher, and every publish then appends the message to it (mmap stores,
+// no write() syscalls on the publish path). The file is two alternating
+// halves, so the journal keeps between size_bytes/2 and size_bytes of the
+// most recent traffic at all times and survives publisher crashes.
+int publisher_attach_journal(SimpleDDSPublisher pub, const char* path, size_t size_bytes);
+// Streams journaled messages with timestamp >= from_timestamp to cb in
+// publish order, oldest half first. Messages come back as SimpleMessage, so
+// replayed text is capped at 255 bytes even though the journal stores the
+// full message. Returns the number of messages replayed, or -1 on error.
+long replay_journal(const char* path, long from_timestamp, SimpleMessageCallback cb, void* ctx);
+
 // Subscriber functions
 SimpleDDSSubscriber create_simple_subscriber(const char* topic_name);
+// Filtered subscription: filter_expression selects on the SimpleMessage
+// fields, e.g. "key = 7" or "key >= 16 AND key < 32 OR message = 'ping'".
+// Supported grammar: "field op literal" terms over key, timestamp, and
+// message, joined by AND/OR (AND binds tighter, no parentheses); ops are
+// = != <> < <= > >= and string literals are single-quoted. The library
+// registers its own filter class for this -- the builtin DDSSQL filter
+// needs a TypeObject the hand-rolled types do not have -- and matching runs
+// inside the middleware against the serialized sample, so samples that do
+// not match are never deserialized or carried across the FFI boundary.
+// The handle behaves like any other subscriber.
+SimpleDDSSubscriber create_filtered_subscriber(const char* topic_name, const char* filter_expression);
 int receive_simple_message(SimpleDDSSubscriber sub, SimpleMessage* msg);
+// Return codes for receive_simple_message_timed()
+#define CARDINAL_RECV_OK       0
+#define CARDINAL_RECV_TIMEOUT  1
+#define CARDINAL_RECV_ERROR   -1
+// Blocks up to timeout_ms for an unread message, then reads it. Unlike
+// receive_simple_message() this distinguishes "nothing arrived" from real
+// failures, so callers can wait with a deadline instead of busy-polling.
+int receive_simple_message_timed(SimpleDDSSubscriber sub, SimpleMessage* msg, int timeout_ms);
+// Drains up to max queued samples in a single call using DataReader::take()
+// with a sequence, writing them into out and setting *got to the count taken.
+// Returns 0 on success (including zero samples), -1 on error.
+int receive_simple_messages(SimpleDDSSubscriber sub, SimpleMessage* out, size_t max, size_t* got);
+// Push delivery: cb is invoked from the FastDDS listener thread the moment a
+// sample arrives, so no polling loop is needed. The SimpleMessage pointer is
+// only valid for the duration of the call. Pass a NULL cb to unregister and
+// fall back to the polling APIs. Returns 0 on success, -1 on error.
+int set_message_callback(SimpleDDSSubscriber sub, SimpleMessageCallback cb, void* ctx);
+// Reads the newest cached sample for one key without touching the rest of
+// the stream (the reader keeps a last-value cache per instance). The sample
+// stays in the cache for later reads. Returns 0 on success, -1 if the key is
+// unknown or has no data.
+int read_latest_for_key(SimpleDDSSubscriber sub, unsigned int key, SimpleMessage* msg);
+// Zero-copy receive built on DataReader::take() with loaned sequences.
+// Borrows the next sample straight out of the reader cache (bypassed
+// same-process messages are served first, from a subscriber-held copy); the
+// caller must hand it back with return_loan() before taking another one.
+// Only one loan may be outstanding per subscriber. Returns 0 on success, -1
+// otherwise.
+int receive_loan(SimpleDDSSubscriber sub, SimpleMessageLoan* loan);
+int return_loan(SimpleDDSSubscriber sub, SimpleMessageLoan* loan);
+// Liveliness counters, maintained from middleware listener events (see
+// CardinalQos.liveliness_lease_ms)
+typedef struct {
+    unsigned int alive_count;          // matched writers currently alive
+    unsigned int not_alive_count;      // matched writers that lost liveliness
+    unsigned long long change_events;  // liveliness transitions observed
+} CardinalLivelinessStats;
+// Snapshot the subscriber's liveliness counters. Returns 0 on success, -1 on error.
+int get_liveliness_changed(SimpleDDSSubscriber sub, CardinalLivelinessStats* stats);
+// Total requested-deadline misses observed by the subscriber (see
+// CardinalQos.deadline_ms)
+unsigned long long get_missed_deadlines(SimpleDDSSubscriber sub);
 void destroy_simple_subscriber(SimpleDDSSubscriber sub);
 
+// Multiplexer: attaches many subscribers to one FastDDS WaitSet so a single
+// blocked thread can service every topic instead of one polling loop each.
+// The mux does not own the subscribers; destroy it before destroying them.
+CardinalMux mux_create(void);
+// Attach a subscriber under a caller-chosen tag (reported back by mux_wait)
+int mux_add(CardinalMux mux, SimpleDDSSubscriber sub, int tag);
+// Block up to timeout_ms for data on any attached subscriber. Fills tags_out
+// (up to max_events entries) with the tags that have data and sets *got.
+// Returns 0 on success -- *got is 0 on a plain timeout -- and -1 on error.
+int mux_wait(CardinalMux mux, int timeout_ms, int* tags_out, size_t max_events, size_t* got);
+void mux_destroy(CardinalMux mux);
+
+// Numeric sample endpoints: CardinalSample on its own topic type
+// ("CardinalSample", memcpy wire format)
+CardinalSamplePublisher create_sample_publisher(const char* topic_name);
+int publish_sample(CardinalSamplePublisher pub, const CardinalSample* sample);
+// Publishes count samples in one FFI crossing. Returns the number written,
+// or -1 on error.
+int publish_samples_batch(CardinalSamplePublisher pub, const CardinalSample* samples, size_t count);
+void destroy_sample_publisher(CardinalSamplePublisher pub);
+
+CardinalSampleSubscriber create_sample_subscriber(const char* topic_name);
+// Returns 0 on success, -1 on no data or error
+int receive_sample(CardinalSampleSubscriber sub, CardinalSample* sample);
+// Drains up to max queued samples into out and sets *got to the count taken.
+// Returns 0 on success (including zero samples), -1 on error.
+int receive_samples(CardinalSampleSubscriber sub, CardinalSample* out, size_t max, size_t* got);
+void destroy_sample_subscriber(CardinalSampleSubscriber sub);
+
+// Digest of one aggregation window (see enable_aggregation())
+typedef struct {
+    unsigned long long count;  // samples in the window
+    double min;
+    double max;
+    double sum;                // mean = sum / count
+    double last;
+    long first_timestamp;      // CardinalSample.timestamp bounds of the window
+    long last_timestamp;
+} CardinalWindowStats;
+
+// Subscriber-side aggregation: samples are folded into count/min/max/sum/last
+// on the middleware listener thread as they arrive, so a high-rate topic
+// costs one FFI crossing per window instead of one per sample. With
+// window_ms > 0 the digest rolls over every window_ms and read_window_stats()
+// returns the last completed window; with window_ms == 0 read_window_stats()
+// returns and resets the running digest. Aggregation replaces the polling
+// receive calls for this subscriber. Returns 0 on success, -1 on error.
+int enable_aggregation(CardinalSampleSubscriber sub, unsigned int window_ms);
+int read_window_stats(CardinalSampleSubscriber sub, CardinalWindowStats* stats);
+
+// Cross-domain bridge: forwards every sample on topic_name from src_domain
+// to dst_domain inside the middleware. The bridge reads and re-publishes the
+// serialized payload bytes untouched -- no deserialization into
+// SimpleMessageData and no re-serialization -- so forwarding costs two
+// memcpys per sample instead of a full decode/encode round trip. Forwarding
+// runs on the middleware listener thread from the moment the handle exists.
+CardinalBridge create_bridge(unsigned int src_domain, unsigned int dst_domain, const char* topic_name);
+void destroy_bridge(CardinalBridge bridge);
+
+// Blob endpoints: arbitrary binary payloads on their own topic type
+// ("CardinalBlob", length-prefixed wire format), so sensor frames travel as
+// raw bytes instead of base64-encoded text squeezed into SimpleMessage.
+CardinalBlobPublisher create_blob_publisher(const char* topic_name);
+int publish_blob(CardinalBlobPublisher pub, const unsigned char* data, size_t size, long timestamp);
+void destroy_blob_publisher(CardinalBlobPublisher pub);
+
+CardinalBlobSubscriber create_blob_subscriber(const char* topic_name);
+// Copies the next blob into buffer (up to capacity bytes) and sets *size to
+// the payload length. Returns 0 on success, -1 on no data, error, or if the
+// blob does not fit in capacity.
+int receive_blob(CardinalBlobSubscriber sub, unsigned char* buffer, size_t capacity, size_t* size, long* timestamp);
+void destroy_blob_subscriber(CardinalBlobSubscriber sub);
+
 #ifdef __cplusplus
 }
 #endif